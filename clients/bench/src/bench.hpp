@@ -0,0 +1,122 @@
+#pragma once
+
+#include <chrono>
+#include <string>
+#include <vector>
+#include <algorithm>
+#include <cstddef>
+#include <cstdio>
+
+namespace bench {
+    inline constexpr double MIN_TIME {0.1};  // Seconds, of one repetition
+    inline constexpr std::size_t REPETITIONS {5};
+
+    struct Result {
+        std::string name;
+        double median {0.0};  // Nanoseconds per iteration
+        double min {0.0};
+        double max {0.0};
+        std::size_t iterations {0};  // Per repetition
+    };
+
+    // Of all the benchmarks that have run
+    inline std::vector<Result>& get_results() {
+        static std::vector<Result> results;
+        return results;
+    }
+
+    // Only the benchmarks containing this in their names are run, if not empty
+    inline std::string& get_filter() {
+        static std::string filter;
+        return filter;
+    }
+
+    // Keep the compiler from optimizing away the computation of a value
+    template<typename T>
+    void do_not_optimize(const T& value) {
+#if defined(__GNUC__)
+        asm volatile("" : : "r,m"(value) : "memory");
+#else
+        static volatile const void* sink;
+        sink = &value;
+#endif
+    }
+
+    /*
+        Call function enough times to be measured reliably, a few times over, and return the median time of an
+        iteration in nanoseconds. The median is less disturbed by the rest of the system than the mean.
+        Return 0.0, if the benchmark was filtered out.
+    */
+    template<typename F>
+    double run(const std::string& name, F&& function) {
+        using namespace std::chrono;
+
+        if (name.find(get_filter()) == std::string::npos) {
+            return 0.0;
+        }
+
+        function();  // Warm up
+
+        std::size_t iterations {1};
+
+        // Find how many iterations take long enough
+        while (true) {
+            const auto begin {steady_clock::now()};
+
+            for (std::size_t i {0}; i < iterations; i++) {
+                function();
+            }
+
+            if (duration<double>(steady_clock::now() - begin).count() >= MIN_TIME) {
+                break;
+            }
+
+            iterations *= 2;
+        }
+
+        std::vector<double> times;
+
+        for (std::size_t repetition {0}; repetition < REPETITIONS; repetition++) {
+            const auto begin {steady_clock::now()};
+
+            for (std::size_t i {0}; i < iterations; i++) {
+                function();
+            }
+
+            const double elapsed {duration<double>(steady_clock::now() - begin).count()};
+
+            times.push_back(elapsed * 1.0e9 / static_cast<double>(iterations));
+        }
+
+        std::sort(times.begin(), times.end());
+
+        Result result;
+        result.name = name;
+        result.median = times[times.size() / 2];
+        result.min = times.front();
+        result.max = times.back();
+        result.iterations = iterations;
+
+        std::printf(
+            "%-56s %12.1f ns %12.1f min %12.1f max %12zu iterations\n",
+            name.c_str(),
+            result.median,
+            result.min,
+            result.max,
+            iterations
+        );
+
+        get_results().push_back(result);
+
+        return result.median;
+    }
+
+    // Print how much faster the second result is, if both have run
+    inline void speedup(const std::string& name, double baseline, double result) {
+        if (baseline == 0.0 || result == 0.0) {
+            return;
+        }
+
+        std::printf("%-56s %12.2fx\n", name.c_str(), baseline / result);
+    }
+}
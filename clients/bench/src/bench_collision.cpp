@@ -0,0 +1,74 @@
+#include <vector>
+#include <random>
+#include <string>
+#include <cstddef>
+#include <cstdint>
+
+#include <glm/glm.hpp>
+
+#include "collision.hpp"
+#include "bench.hpp"
+
+static void sphere_boxes(std::size_t count) {
+    std::mt19937 random {42};
+    std::uniform_real_distribution<float> position {-8.0f, 8.0f};
+
+    std::vector<Box> boxes;
+    BoxArray box_array;
+
+    for (std::size_t i {0}; i < count; i++) {
+        Box b;
+        b.position = glm::vec3(position(random), position(random) * 0.25f, position(random));
+        b.width = 1.0f;
+        b.height = 0.5f;
+        b.depth = 0.5f;
+
+        boxes.push_back(b);
+        box_array.add(b);
+    }
+
+    Sphere s;
+    s.position = glm::vec3(0.0f, 0.6f, 0.0f);
+    s.radius = 2.0f;
+
+    const std::string suffix {"/" + std::to_string(count)};
+
+    const double scalar {bench::run("collision_sphere_box" + suffix, [&]() {
+        std::uint64_t hits {0};
+
+        for (std::size_t i {0}; i < boxes.size(); i++) {
+            if (collision_sphere_box(s, boxes[i])) {
+                hits |= std::uint64_t {1} << (i % 64);
+            }
+        }
+
+        bench::do_not_optimize(hits);
+    })};
+
+    std::vector<std::uint64_t> hits;
+
+    const double batch {bench::run("collision_sphere_boxes" + suffix, [&]() {
+        collision_sphere_boxes(s, box_array, hits);
+
+        bench::do_not_optimize(hits.data());
+    })};
+
+    bench::speedup("speedup" + suffix, scalar, batch);
+
+    // Only called after a hit, but its cost doesn't depend on that
+    bench::run("sphere_box_side_2d" + suffix, [&]() {
+        unsigned int sides {0};
+
+        for (const Box& box : boxes) {
+            sides += static_cast<unsigned int>(sphere_box_side_2d(s, box));
+        }
+
+        bench::do_not_optimize(sides);
+    });
+}
+
+void bench_collision() {
+    sphere_boxes(8);
+    sphere_boxes(64);
+    sphere_boxes(1024);
+}
@@ -0,0 +1,177 @@
+#include <memory>
+#include <string>
+#include <vector>
+#include <utility>
+#include <random>
+#include <cstddef>
+#include <cstdio>
+
+#include <engine/font.hpp>
+#include <engine/mesh.hpp>
+#include <engine/shader.hpp>
+#include <engine/material.hpp>
+#include <engine/renderable.hpp>
+#include <engine/transform_stage.hpp>
+#include <engine/window.hpp>
+#include <engine/panic.hpp>
+#include <glm/glm.hpp>
+#include <glm/gtc/matrix_transform.hpp>
+#include <resmanager/resmanager.hpp>
+
+#include "bench.hpp"
+
+using namespace resmanager::literals;
+
+namespace {
+    struct Model {
+        const char* file_path {nullptr};
+        const char* object_name {nullptr};
+        bb::Mesh::Type type {};
+    };
+}
+
+// The same as the game and the teapot load
+static const Model MODELS[] {
+    { "data/models/ball.obj", "Sphere", bb::Mesh::Type::PTN },
+    { "data/models/brick.obj", "Brick", bb::Mesh::Type::PTN },
+    { "data/models/lamp.obj", "Stand", bb::Mesh::Type::PTN },
+    { "data/models/lamp.obj", "Bulb", bb::Mesh::Type::P },
+    { "data/models/paddle.obj", "Paddle", bb::Mesh::Type::PTN },
+    { "data/models/platform.obj", "Platform", bb::Mesh::Type::PTN },
+    { "data/models/teapot.obj", bb::Mesh::DEFAULT_OBJECT, bb::Mesh::Type::PN }
+};
+
+static void mesh() {
+    for (const Model& model : MODELS) {
+        bench::run(std::string("Mesh/") + model.file_path + "/" + model.object_name, [&]() {
+            const bb::Mesh mesh {model.file_path, model.object_name, model.type};
+
+            bench::do_not_optimize(mesh.get_vertices_size());
+        });
+    }
+}
+
+static void font() {
+    // The same as the game uses
+    auto font {std::make_shared<bb::Font>("data/fonts/CodeNewRoman/code-new-roman.regular.ttf", 40.0f, 8, 180, 40, 512)};
+    font->begin_baking();
+    font->bake_ascii();
+    font->end_baking();
+
+    const std::pair<const char*, std::string> strings[] {
+        { "short", "Score: 1250" },
+        { "long", "The quick brown fox jumps over the lazy dog, while the ball bounces off the paddle. 0123456789" }
+    };
+
+    for (const auto& [name, string] : strings) {
+        std::vector<float> buffer;
+
+        bench::run(std::string("Font::render/") + name, [&]() {
+            buffer.clear();
+            font->render(string, buffer);
+
+            bench::do_not_optimize(buffer.data());
+        });
+
+        bench::run(std::string("Font::get_string_size/") + name, [&]() {
+            const auto size {font->get_string_size(string, 0.5f)};
+
+            bench::do_not_optimize(size);
+        });
+    }
+}
+
+static void transform_stage(std::size_t count) {
+    std::mt19937 random {42};
+    std::uniform_real_distribution<float> position {-8.0f, 8.0f};
+    std::uniform_real_distribution<float> rotation {-3.14f, 3.14f};
+
+    std::vector<bb::Renderable> renderables;
+
+    for (std::size_t i {0}; i < count; i++) {
+        bb::Renderable renderable;
+        renderable.position = glm::vec3(position(random), position(random), position(random));
+        renderable.rotation = glm::vec3(rotation(random), rotation(random), rotation(random));
+        renderable.scale = 0.5f;
+
+        renderables.push_back(renderable);
+    }
+
+    const std::string suffix {"/" + std::to_string(count)};
+
+    std::vector<glm::mat4> matrices (count);
+
+    // How the renderer used to compute every matrix
+    const double scalar {bench::run("glm::translate rotate scale" + suffix, [&]() {
+        for (std::size_t i {0}; i < renderables.size(); i++) {
+            glm::mat4 matrix {1.0f};
+            matrix = glm::translate(matrix, renderables[i].position);
+            matrix = glm::rotate(matrix, renderables[i].rotation.x, glm::vec3(1.0f, 0.0f, 0.0f));
+            matrix = glm::rotate(matrix, renderables[i].rotation.y, glm::vec3(0.0f, 1.0f, 0.0f));
+            matrix = glm::rotate(matrix, renderables[i].rotation.z, glm::vec3(0.0f, 0.0f, 1.0f));
+            matrix = glm::scale(matrix, glm::vec3(renderables[i].scale));
+
+            matrices[i] = matrix;
+        }
+
+        bench::do_not_optimize(matrices.data());
+    })};
+
+    bb::TransformStage stage;
+
+    const double batch {bench::run("TransformStage::compute" + suffix, [&]() {
+        stage.compute(renderables);
+        bench::do_not_optimize(stage.get_matrices().data());
+    })};
+
+    bench::speedup("speedup" + suffix, scalar, batch);
+}
+
+static void material_instance() {
+    // The material of the textured objects of the game
+    auto shader {std::make_shared<bb::Shader>(
+        "data/shaders/simple_textured_shadows.vert",
+        "data/shaders/simple_textured_shadows.frag",
+        "data/shaders/common"
+    )};
+
+    auto material {std::make_shared<bb::Material>(shader)};
+    material->add_texture("u_material.ambient_diffuse"_H);
+    material->add_uniform(bb::Material::Uniform::Vec3, "u_material.specular"_H);
+    material->add_uniform(bb::Material::Uniform::Float, "u_material.shininess"_H);
+
+    bb::MaterialInstance material_instance {material};
+    material_instance.set_texture("u_material.ambient_diffuse"_H, 0u, 0);
+    material_instance.set_vec3("u_material.specular"_H, glm::vec3(0.25f));
+    material_instance.set_float("u_material.shininess"_H, 16.0f);
+
+    // The driver does some of the work here too
+    bench::run("MaterialInstance::bind_and_upload", [&]() {
+        material_instance.bind_and_upload();
+    });
+}
+
+void bench_engine() {
+    mesh();
+    transform_stage(100);
+    transform_stage(1000);
+    transform_stage(10000);
+
+    // Fonts and shaders need an OpenGL context, which a headless window has without a display
+    bb::WindowProperties properties;
+    properties.width = 1;
+    properties.height = 1;
+    properties.headless = true;
+
+    std::unique_ptr<bb::Window> window;
+
+    try {
+        window = std::make_unique<bb::Window>(properties, nullptr);
+    } catch (bb::RuntimeError) {
+        std::printf("Skipping the benchmarks that need an OpenGL context\n");
+        return;
+    }
+
+    font();
+    material_instance();
+}
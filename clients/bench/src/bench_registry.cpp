@@ -0,0 +1,94 @@
+#include <unordered_map>
+#include <vector>
+#include <random>
+#include <string>
+#include <cstddef>
+
+#include <entt/entity/registry.hpp>
+#include <glm/glm.hpp>
+
+#include "ball.hpp"
+#include "components.hpp"
+#include "bench.hpp"
+
+namespace {
+    // What the level used before, one object with everything in it per ball
+    struct OldBall {
+        Ball ball;
+        Transform transform;
+        SphereCollider collider;
+    };
+}
+
+static void ball_storage(std::size_t count) {
+    std::mt19937 random {42};
+
+    std::unordered_map<unsigned int, OldBall> map;
+    unsigned int next_id {0};
+
+    entt::registry registry;
+    std::vector<entt::entity> entities;
+
+    for (std::size_t i {0}; i < count; i++) {
+        map[next_id++] = OldBall();
+
+        const entt::entity entity {registry.create()};
+        registry.emplace<Transform>(entity);
+        registry.emplace<SphereCollider>(entity);
+        registry.emplace<Ball>(entity);
+
+        entities.push_back(entity);
+    }
+
+    const std::string suffix {"/" + std::to_string(count)};
+
+    // Replace random elements, keeping the size constant, which also scatters the map nodes in memory
+    std::uniform_int_distribution<std::size_t> element {0, count - 1};
+
+    const double map_churn {bench::run("unordered_map erase insert" + suffix, [&]() {
+        auto iter {map.begin()};
+        std::advance(iter, element(random) % 8);  // Avoid walking the buckets for too long
+
+        map.erase(iter);
+        map[next_id++] = OldBall();
+    })};
+
+    const double registry_churn {bench::run("registry destroy create" + suffix, [&]() {
+        const std::size_t i {element(random)};
+
+        registry.destroy(entities[i]);
+
+        const entt::entity entity {registry.create()};
+        registry.emplace<Transform>(entity);
+        registry.emplace<SphereCollider>(entity);
+        registry.emplace<Ball>(entity);
+
+        entities[i] = entity;
+    })};
+
+    bench::speedup("speedup destroy create" + suffix, map_churn, registry_churn);
+
+    // The movement pass only needs the position and the velocity
+    const double map_iterate {bench::run("unordered_map iterate" + suffix, [&]() {
+        for (auto& [_, old_ball] : map) {
+            old_ball.transform.position += old_ball.ball.velocity * 0.016f;
+        }
+
+        bench::do_not_optimize(map);
+    })};
+
+    const double registry_iterate {bench::run("registry view iterate" + suffix, [&]() {
+        registry.view<Transform, Ball>().each([](Transform& transform, const Ball& ball) {
+            transform.position += ball.velocity * 0.016f;
+        });
+
+        bench::do_not_optimize(registry);
+    })};
+
+    bench::speedup("speedup iterate" + suffix, map_iterate, registry_iterate);
+}
+
+void bench_registry() {
+    ball_storage(16);
+    ball_storage(1024);
+}
@@ -0,0 +1,95 @@
+#include <string>
+#include <vector>
+#include <cstddef>
+#include <cstdint>
+
+#include <engine/random.hpp>
+#include <entt/entity/registry.hpp>
+
+#include "simulation.hpp"
+#include "level_file.hpp"
+#include "constants.hpp"
+#include "bench.hpp"
+
+static const char* LEVELS[] {
+    "data/levels/adventure/level1.json",
+    "data/levels/adventure/level2.json",
+    "data/levels/adventure/level3.json",
+    "data/levels/adventure/level4.json",
+    "data/levels/adventure/level5.json"
+};
+
+// Bricks stacked in layers from the ground up, so that none of them falls
+static LevelDescription stacked_level(std::size_t count) {
+    LevelDescription level;
+    level.name = "stacked";
+
+    for (int y {BRICKS_GRID_MIN_Y}; y <= BRICKS_GRID_MAX_Y; y++) {
+        for (int z {BRICKS_GRID_MIN_Z}; z <= BRICKS_GRID_MAX_Z; z++) {
+            for (int x {BRICKS_GRID_MIN_X}; x <= BRICKS_GRID_MAX_X; x++) {
+                if (level.bricks.size() == count) {
+                    return level;
+                }
+
+                LevelFileBrick brick;
+                brick.x = static_cast<std::int8_t>(x);
+                brick.y = static_cast<std::int8_t>(y);
+                brick.z = static_cast<std::int8_t>(z);
+                brick.type = static_cast<std::uint8_t>(level.bricks.size() % 4);
+
+                level.bricks.push_back(brick);
+            }
+        }
+    }
+
+    return level;
+}
+
+struct GameSimulationBench {
+    // The worst case, in which every column has to be checked, as if bricks were destroyed everywhere
+    static void update_bricks(std::size_t count) {
+        entt::registry registry;
+        GameSimulation simulation {registry};
+        simulation.start(stacked_level(count), 0, 3u, 42u);
+
+        bench::run("update_bricks/" + std::to_string(count), [&]() {
+            simulation.unstable_columns.set();
+            simulation.update_bricks();
+
+            bench::do_not_optimize(simulation.unstable_columns);
+        });
+    }
+};
+
+static void load_level(const char* file_path) {
+    const std::string suffix {std::string("/") + file_path};
+
+    bench::run("parse_level_json" + suffix, [&]() {
+        LevelDescription level;
+        const bool success {parse_level_json(file_path, level)};
+
+        bench::do_not_optimize(success);
+    });
+
+    entt::registry registry;
+    bb::Random random {42u};
+
+    // Like the game, this reads the compiled level instead, if it's fresh
+    bench::run("load_level" + suffix, [&]() {
+        registry.clear();
+
+        const bool success {GameSimulation::load_level(file_path, registry, random)};
+
+        bench::do_not_optimize(success);
+    });
+}
+
+void bench_simulation() {
+    GameSimulationBench::update_bricks(16);
+    GameSimulationBench::update_bricks(144);
+    GameSimulationBench::update_bricks(720);
+
+    for (const char* file_path : LEVELS) {
+        load_level(file_path);
+    }
+}
@@ -0,0 +1,107 @@
+#include <string>
+#include <fstream>
+#include <cstring>
+#include <cstdio>
+
+#include <nlohmann/json.hpp>
+
+#include "bench.hpp"
+
+void bench_collision();
+void bench_registry();
+void bench_simulation();
+void bench_engine();
+
+struct Options {
+    std::string json_file;
+    std::string filter;
+};
+
+static void print_usage() {
+    std::printf("Usage: bb-bench [--json FILE] [--filter TEXT]\n");
+}
+
+static bool parse_options(int argc, char** argv, Options& options) {
+    for (int i {1}; i < argc; i += 2) {
+        if (i + 1 == argc) {
+            return false;
+        }
+
+        const char* name {argv[i]};
+        const char* value {argv[i + 1]};
+
+        if (std::strcmp(name, "--json") == 0) {
+            options.json_file = value;
+        } else if (std::strcmp(name, "--filter") == 0) {
+            options.filter = value;
+        } else {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+// Only what doesn't change between runs on the same machine goes in, so that the files can be diffed
+static bool write_json(const std::string& file_path) {
+    nlohmann::json root;
+
+#ifdef NDEBUG
+    root["build"] = "release";
+#else
+    root["build"] = "debug";
+#endif
+
+    root["repetitions"] = bench::REPETITIONS;
+
+    nlohmann::json& benchmarks {root["benchmarks"]};
+    benchmarks = nlohmann::json::array();
+
+    for (const bench::Result& result : bench::get_results()) {
+        nlohmann::json benchmark;
+        benchmark["name"] = result.name;
+        benchmark["median_ns"] = result.median;
+        benchmark["min_ns"] = result.min;
+        benchmark["max_ns"] = result.max;
+        benchmark["iterations"] = result.iterations;
+
+        benchmarks.push_back(benchmark);
+    }
+
+    std::ofstream stream {file_path, std::ios::trunc};
+
+    if (!stream.is_open()) {
+        return false;
+    }
+
+    stream << root.dump(2) << '\n';
+
+    return stream.good();
+}
+
+int main(int argc, char** argv) {
+    Options options;
+
+    if (!parse_options(argc, argv, options)) {
+        print_usage();
+        return 1;
+    }
+
+    bench::get_filter() = options.filter;
+
+    bench_collision();
+    bench_registry();
+    bench_simulation();
+    bench_engine();
+
+    if (!options.json_file.empty()) {
+        if (!write_json(options.json_file)) {
+            std::printf("Could not write results `%s`\n", options.json_file.c_str());
+            return 1;
+        }
+
+        std::printf("Wrote results `%s`\n", options.json_file.c_str());
+    }
+
+    return 0;
+}
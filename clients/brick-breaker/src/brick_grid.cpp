@@ -0,0 +1,113 @@
+#include "brick_grid.hpp"
+
+#include <algorithm>
+#include <cassert>
+
+#include "brick.hpp"
+
+void BrickGrid::clear() {
+    for (auto& cell : cells) {
+        cell.clear();
+    }
+
+    occupied.reset();
+}
+
+void BrickGrid::insert(entt::entity brick, glm::ivec3 grid) {
+    const std::size_t i {cell_index(grid)};
+
+    cells[i].push_back(brick);
+    occupied.set(i);
+}
+
+void BrickGrid::remove(entt::entity brick, glm::ivec3 grid) {
+    const std::size_t i {cell_index(grid)};
+    auto& cell {cells[i]};
+
+    const auto iter {std::find(cell.begin(), cell.end(), brick)};
+    assert(iter != cell.end());
+
+    // Order in a cell doesn't matter
+    *iter = cell.back();
+    cell.pop_back();
+
+    if (cell.empty()) {
+        occupied.reset(i);
+    }
+}
+
+void BrickGrid::move(entt::entity brick, glm::ivec3 from, glm::ivec3 to) {
+    remove(brick, from);
+    insert(brick, to);
+}
+
+void BrickGrid::query(const Sphere& sphere, std::vector<entt::entity>& result) const {
+    const glm::ivec3 min {world_to_grid(sphere.position - glm::vec3(sphere.radius))};
+    const glm::ivec3 max {world_to_grid(sphere.position + glm::vec3(sphere.radius))};
+
+    if (max.x < BRICKS_GRID_MIN_X || min.x > BRICKS_GRID_MAX_X) {
+        return;
+    }
+
+    if (max.y < BRICKS_GRID_MIN_Y || min.y > BRICKS_GRID_MAX_Y) {
+        return;
+    }
+
+    if (max.z < BRICKS_GRID_MIN_Z || min.z > BRICKS_GRID_MAX_Z) {
+        return;
+    }
+
+    const int min_x {glm::max(min.x, BRICKS_GRID_MIN_X)};
+    const int max_x {glm::min(max.x, BRICKS_GRID_MAX_X)};
+    const int min_y {glm::max(min.y, BRICKS_GRID_MIN_Y)};
+    const int max_y {glm::min(max.y, BRICKS_GRID_MAX_Y)};
+    const int min_z {glm::max(min.z, BRICKS_GRID_MIN_Z)};
+    const int max_z {glm::min(max.z, BRICKS_GRID_MAX_Z)};
+
+    for (int y {min_y}; y <= max_y; y++) {
+        for (int z {min_z}; z <= max_z; z++) {
+            for (int x {min_x}; x <= max_x; x++) {
+                const auto& cell {cells[cell_index(glm::ivec3(x, y, z))]};
+                result.insert(result.end(), cell.begin(), cell.end());
+            }
+        }
+    }
+}
+
+bool BrickGrid::is_supported(glm::ivec3 grid) const {
+    if (grid.y == BRICKS_GRID_MIN_Y) {
+        return true;
+    }
+
+    return is_occupied(glm::ivec3(grid.x, grid.y - 1, grid.z));
+}
+
+glm::ivec3 BrickGrid::world_to_grid(glm::vec3 position) {
+    // Inverse of Brick::grid_to_position; cells are twice the brick dimensions, as these are half extents
+    const glm::vec3 dimensions {Brick::get_dimensions()};
+
+    return glm::ivec3(
+        static_cast<int>(glm::floor((position.x + dimensions.x) / (dimensions.x * 2.0f))),
+        static_cast<int>(glm::floor((position.y - GROUND_LEVEL) / (dimensions.y * 2.0f))),
+        static_cast<int>(glm::floor((position.z + dimensions.z) / (dimensions.z * 2.0f)))
+    );
+}
+
+std::size_t BrickGrid::column_index(glm::ivec3 grid) {
+    const int x {grid.x - BRICKS_GRID_MIN_X};
+    const int z {grid.z - BRICKS_GRID_MIN_Z};
+
+    return static_cast<std::size_t>(z * SIZE_X + x);
+}
+
+std::size_t BrickGrid::cell_index(glm::ivec3 grid) {
+    assert(grid.x >= BRICKS_GRID_MIN_X && grid.x <= BRICKS_GRID_MAX_X);
+    assert(grid.y >= BRICKS_GRID_MIN_Y && grid.y <= BRICKS_GRID_MAX_Y);
+    assert(grid.z >= BRICKS_GRID_MIN_Z && grid.z <= BRICKS_GRID_MAX_Z);
+
+    const int x {grid.x - BRICKS_GRID_MIN_X};
+    const int y {grid.y - BRICKS_GRID_MIN_Y};
+    const int z {grid.z - BRICKS_GRID_MIN_Z};
+
+    return static_cast<std::size_t>((y * SIZE_Z + z) * SIZE_X + x);
+}
@@ -0,0 +1,47 @@
+#pragma once
+
+#include <vector>
+#include <array>
+#include <bitset>
+#include <cstddef>
+
+#include <entt/entity/entity.hpp>
+#include <glm/glm.hpp>
+
+#include "constants.hpp"
+#include "collision.hpp"
+
+// Spatial index of the bricks, with one cell for every position in the bricks grid
+class BrickGrid {
+public:
+    static constexpr int SIZE_X {BRICKS_GRID_MAX_X - BRICKS_GRID_MIN_X + 1};
+    static constexpr int SIZE_Y {BRICKS_GRID_MAX_Y - BRICKS_GRID_MIN_Y + 1};
+    static constexpr int SIZE_Z {BRICKS_GRID_MAX_Z - BRICKS_GRID_MIN_Z + 1};
+
+    void clear();
+    void insert(entt::entity brick, glm::ivec3 grid);
+    void remove(entt::entity brick, glm::ivec3 grid);
+    void move(entt::entity brick, glm::ivec3 from, glm::ivec3 to);
+
+    // Append the bricks from all the cells overlapped by the sphere
+    void query(const Sphere& sphere, std::vector<entt::entity>& result) const;
+
+    const std::vector<entt::entity>& get_bricks(glm::ivec3 grid) const { return cells[cell_index(grid)]; }
+    bool is_occupied(glm::ivec3 grid) const { return occupied.test(cell_index(grid)); }
+
+    // Check if there is something below, be it the ground or another brick
+    bool is_supported(glm::ivec3 grid) const;
+
+    static glm::ivec3 world_to_grid(glm::vec3 position);
+
+    // Index of a vertical column of cells, in the range [0, SIZE_X * SIZE_Z)
+    static std::size_t column_index(glm::ivec3 grid);
+private:
+    static std::size_t cell_index(glm::ivec3 grid);
+
+    // Normally there is at most one brick per cell, but nothing stops levels from stacking them
+    std::array<std::vector<entt::entity>, SIZE_X * SIZE_Y * SIZE_Z> cells;
+
+    // Dense mirror of which cells are not empty
+    std::bitset<SIZE_X * SIZE_Y * SIZE_Z> occupied;
+};
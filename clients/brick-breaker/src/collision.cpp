@@ -1,36 +1,62 @@
 #include "collision.hpp"
 
-#include <cassert>
+#if defined(__AVX__)
+    #include <immintrin.h>
+#elif defined(__SSE2__) || defined(_M_X64)
+    #include <emmintrin.h>
+#endif
 
 // https://developer.mozilla.org/en-US/docs/Games/Techniques/3D_collision_detection
+// Real-Time Collision Detection by Christer Ericson, 5.5.7 Intersecting moving sphere against AABB
 
-enum Orientation {
-    Collinear,
-    Clockwise,
-    CounterClockwise
-};
+static glm::vec3 closest_point_box(glm::vec3 point, const Box& box) {
+    return glm::vec3(
+        glm::max(box.position.x - box.width, glm::min(point.x, box.position.x + box.width)),
+        glm::max(box.position.y - box.height, glm::min(point.y, box.position.y + box.height)),
+        glm::max(box.position.z - box.depth, glm::min(point.z, box.position.z + box.depth))
+    );
+}
 
-static Orientation orientation(glm::vec2 p, glm::vec2 q, glm::vec2 r) {
-    const float result {(q.y - p.y) * (r.x - q.x) - (q.x - p.x) * (r.y - q.y)};
+// Direction in the XZ plane in which to push the sphere out of the box
+static glm::vec3 sphere_box_normal_2d(const Sphere& sphere, const Box& box) {
+    const glm::vec3 closest {closest_point_box(sphere.position, box)};
+    const glm::vec3 difference {sphere.position.x - closest.x, 0.0f, sphere.position.z - closest.z};
 
-    if (result == 0.0f) {  // Never happens
-        return Collinear;
+    if (difference.x != 0.0f || difference.z != 0.0f) {
+        return glm::normalize(difference);
     }
 
-    return result > 0.0f ? Clockwise : CounterClockwise;
+    // The center is inside the box, so choose the side of least penetration
+    const float offset_x {sphere.position.x - box.position.x};
+    const float offset_z {sphere.position.z - box.position.z};
+
+    if (box.width - glm::abs(offset_x) < box.depth - glm::abs(offset_z)) {
+        return glm::vec3(offset_x < 0.0f ? -1.0f : 1.0f, 0.0f, 0.0f);
+    } else {
+        return glm::vec3(0.0f, 0.0f, offset_z < 0.0f ? -1.0f : 1.0f);
+    }
 }
 
-static bool intersection_segments(glm::vec2 p1, glm::vec2 q1, glm::vec2 p2, glm::vec2 q2) {
-    const Orientation o1 {orientation(p1, q1, p2)};
-    const Orientation o2 {orientation(p1, q1, q2)};
-    const Orientation o3 {orientation(p2, q2, p1)};
-    const Orientation o4 {orientation(p2, q2, q1)};
+// Moving circle against a resting circle, in the XZ plane
+static bool sweep_circle_point(glm::vec2 position, glm::vec2 displacement, float radius, glm::vec2 point, float& time) {
+    const glm::vec2 m {position - point};
+    const float a {glm::dot(displacement, displacement)};
+    const float b {glm::dot(m, displacement)};
+    const float c {glm::dot(m, m) - radius * radius};
 
-    if (o1 != o2 && o3 != o4) {
-        return true;
+    if (a == 0.0f || b >= 0.0f) {
+        return false;  // Not moving, or moving away
+    }
+
+    const float discriminant {b * b - a * c};
+
+    if (discriminant < 0.0f) {
+        return false;
     }
 
-    return false;
+    time = glm::max((-b - glm::sqrt(discriminant)) / a, 0.0f);
+
+    return time <= 1.0f;
 }
 
 bool collision_sphere_box(const Sphere& sphere, const Box& box) {
@@ -45,50 +71,205 @@ bool collision_sphere_box(const Sphere& sphere, const Box& box) {
     const float y {glm::max(box_min_y, glm::min(sphere.position.y, box_max_y))};
     const float z {glm::max(box_min_z, glm::min(sphere.position.z, box_max_z))};
 
-    const float distance {glm::sqrt(
+    // No need for the square root
+    const float distance_squared {
         (x - sphere.position.x) * (x - sphere.position.x) +
         (y - sphere.position.y) * (y - sphere.position.y) +
         (z - sphere.position.z) * (z - sphere.position.z)
-    )};
+    };
+
+    return distance_squared < sphere.radius * sphere.radius;
+}
 
-    return distance < sphere.radius;
+void BoxArray::add(const Box& box) {
+    min_x.push_back(box.position.x - box.width);
+    min_y.push_back(box.position.y - box.height);
+    min_z.push_back(box.position.z - box.depth);
+    max_x.push_back(box.position.x + box.width);
+    max_y.push_back(box.position.y + box.height);
+    max_z.push_back(box.position.z + box.depth);
+}
+
+void BoxArray::clear() {
+    min_x.clear();
+    min_y.clear();
+    min_z.clear();
+    max_x.clear();
+    max_y.clear();
+    max_z.clear();
+}
+
+void collision_sphere_boxes(const Sphere& sphere, const BoxArray& boxes, std::vector<std::uint64_t>& hits) {
+    const std::size_t count {boxes.size()};
+
+    const float radius_squared {sphere.radius * sphere.radius};
+
+    hits.assign((count + 63) / 64, 0);
+
+    std::size_t i {0};
+
+#if defined(__AVX__)
+    const __m256 sphere_x {_mm256_set1_ps(sphere.position.x)};
+    const __m256 sphere_y {_mm256_set1_ps(sphere.position.y)};
+    const __m256 sphere_z {_mm256_set1_ps(sphere.position.z)};
+    const __m256 radius_squared_8 {_mm256_set1_ps(radius_squared)};
+
+    for (; i + 8 <= count; i += 8) {
+        const __m256 x {_mm256_max_ps(_mm256_loadu_ps(&boxes.min_x[i]), _mm256_min_ps(sphere_x, _mm256_loadu_ps(&boxes.max_x[i])))};
+        const __m256 y {_mm256_max_ps(_mm256_loadu_ps(&boxes.min_y[i]), _mm256_min_ps(sphere_y, _mm256_loadu_ps(&boxes.max_y[i])))};
+        const __m256 z {_mm256_max_ps(_mm256_loadu_ps(&boxes.min_z[i]), _mm256_min_ps(sphere_z, _mm256_loadu_ps(&boxes.max_z[i])))};
+
+        const __m256 dx {_mm256_sub_ps(x, sphere_x)};
+        const __m256 dy {_mm256_sub_ps(y, sphere_y)};
+        const __m256 dz {_mm256_sub_ps(z, sphere_z)};
+
+        const __m256 distance_squared {_mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(dx, dx), _mm256_mul_ps(dy, dy)), _mm256_mul_ps(dz, dz))};
+        const int mask {_mm256_movemask_ps(_mm256_cmp_ps(distance_squared, radius_squared_8, _CMP_LT_OQ))};
+
+        // Groups of 8 never straddle two words
+        hits[i / 64] |= static_cast<std::uint64_t>(mask) << (i % 64);
+    }
+#elif defined(__SSE2__) || defined(_M_X64)
+    const __m128 sphere_x {_mm_set1_ps(sphere.position.x)};
+    const __m128 sphere_y {_mm_set1_ps(sphere.position.y)};
+    const __m128 sphere_z {_mm_set1_ps(sphere.position.z)};
+    const __m128 radius_squared_4 {_mm_set1_ps(radius_squared)};
+
+    for (; i + 4 <= count; i += 4) {
+        const __m128 x {_mm_max_ps(_mm_loadu_ps(&boxes.min_x[i]), _mm_min_ps(sphere_x, _mm_loadu_ps(&boxes.max_x[i])))};
+        const __m128 y {_mm_max_ps(_mm_loadu_ps(&boxes.min_y[i]), _mm_min_ps(sphere_y, _mm_loadu_ps(&boxes.max_y[i])))};
+        const __m128 z {_mm_max_ps(_mm_loadu_ps(&boxes.min_z[i]), _mm_min_ps(sphere_z, _mm_loadu_ps(&boxes.max_z[i])))};
+
+        const __m128 dx {_mm_sub_ps(x, sphere_x)};
+        const __m128 dy {_mm_sub_ps(y, sphere_y)};
+        const __m128 dz {_mm_sub_ps(z, sphere_z)};
+
+        const __m128 distance_squared {_mm_add_ps(_mm_add_ps(_mm_mul_ps(dx, dx), _mm_mul_ps(dy, dy)), _mm_mul_ps(dz, dz))};
+        const int mask {_mm_movemask_ps(_mm_cmplt_ps(distance_squared, radius_squared_4))};
+
+        // Groups of 4 never straddle two words
+        hits[i / 64] |= static_cast<std::uint64_t>(mask) << (i % 64);
+    }
+#endif
+
+    // The remaining boxes, or all of them without SIMD
+    for (; i < count; i++) {
+        const float x {glm::max(boxes.min_x[i], glm::min(sphere.position.x, boxes.max_x[i]))};
+        const float y {glm::max(boxes.min_y[i], glm::min(sphere.position.y, boxes.max_y[i]))};
+        const float z {glm::max(boxes.min_z[i], glm::min(sphere.position.z, boxes.max_z[i]))};
+
+        const float distance_squared {
+            (x - sphere.position.x) * (x - sphere.position.x) +
+            (y - sphere.position.y) * (y - sphere.position.y) +
+            (z - sphere.position.z) * (z - sphere.position.z)
+        };
+
+        if (distance_squared < radius_squared) {
+            hits[i / 64] |= std::uint64_t {1} << (i % 64);
+        }
+    }
 }
 
 SphereBoxSide sphere_box_side_2d(const Sphere& sphere, const Box& box) {
-    const glm::vec2 line1 {box.position.x, box.position.z};
-    glm::vec2 line2 {sphere.position.x, sphere.position.z};
-    line2 += (line2 - line1);  // Enlarge this segment a bit
+    return side_from_normal(sphere_box_normal_2d(sphere, box));
+}
 
-    const glm::vec2 front1 {box.position.x - box.width, box.position.z + box.depth};
-    const glm::vec2 front2 {box.position.x + box.width, box.position.z + box.depth};
+bool sweep_sphere_box(const Sphere& sphere, glm::vec3 displacement, const Box& box, Contact& contact) {
+    // Balls and orbs only move horizontally, so the vertical extents must already overlap
+    if (glm::abs(sphere.position.y - box.position.y) >= box.height + sphere.radius) {
+        return false;
+    }
 
-    const glm::vec2 back1 {box.position.x - box.width, box.position.z - box.depth};
-    const glm::vec2 back2 {box.position.x + box.width, box.position.z - box.depth};
+    if (collision_sphere_box(sphere, box)) {
+        const glm::vec3 normal {sphere_box_normal_2d(sphere, box)};
 
-    const glm::vec2 left1 {box.position.x - box.width, box.position.z - box.depth};
-    const glm::vec2 left2 {box.position.x - box.width, box.position.z + box.depth};
+        if (glm::dot(normal, displacement) >= 0.0f) {
+            return false;  // Already separating
+        }
 
-    const glm::vec2 right1 {box.position.x + box.width, box.position.z - box.depth};
-    const glm::vec2 right2 {box.position.x + box.width, box.position.z + box.depth};
+        contact.time = 0.0f;
+        contact.normal = normal;
 
-    if (intersection_segments(line1, line2, front1, front2)) {
-        return SphereBoxSide::Front;
+        return true;
     }
 
-    if (intersection_segments(line1, line2, back1, back2)) {
-        return SphereBoxSide::Back;
+    const glm::vec2 position {sphere.position.x, sphere.position.z};
+    const glm::vec2 direction {displacement.x, displacement.z};
+    const glm::vec2 center {box.position.x, box.position.z};
+    const glm::vec2 extents {box.width, box.depth};
+
+    // Intersect the ray with the box expanded by the radius, one slab at a time
+    float time_enter {0.0f};
+    float time_exit {1.0f};
+    glm::vec2 normal {};
+
+    for (int axis {0}; axis < 2; axis++) {
+        const float min {center[axis] - extents[axis] - sphere.radius};
+        const float max {center[axis] + extents[axis] + sphere.radius};
+
+        if (direction[axis] == 0.0f) {
+            if (position[axis] <= min || position[axis] >= max) {
+                return false;
+            }
+
+            continue;
+        }
+
+        const bool positive {direction[axis] > 0.0f};
+        const float near {((positive ? min : max) - position[axis]) / direction[axis]};
+        const float far {((positive ? max : min) - position[axis]) / direction[axis]};
+
+        if (near > time_enter) {
+            time_enter = near;
+            normal = glm::vec2(0.0f);
+            normal[axis] = positive ? -1.0f : 1.0f;
+        }
+
+        time_exit = glm::min(time_exit, far);
+
+        if (time_enter >= time_exit) {
+            return false;
+        }
     }
 
-    if (intersection_segments(line1, line2, left1, left2)) {
-        return SphereBoxSide::Left;
+    const glm::vec2 point {position + direction * time_enter};
+    const glm::vec2 offset {point - center};
+
+    // Hitting the rounded corners of the expanded box is a hit against the corner points of the box
+    if (glm::abs(offset.x) > extents.x && glm::abs(offset.y) > extents.y) {
+        const glm::vec2 corner {
+            center.x + (offset.x < 0.0f ? -extents.x : extents.x),
+            center.y + (offset.y < 0.0f ? -extents.y : extents.y)
+        };
+
+        float time {};
+
+        if (!sweep_circle_point(position, direction, sphere.radius, corner, time)) {
+            return false;
+        }
+
+        const glm::vec2 corner_normal {glm::normalize(position + direction * time - corner)};
+
+        contact.time = time;
+        contact.normal = glm::vec3(corner_normal.x, 0.0f, corner_normal.y);
+
+        return true;
     }
 
-    if (intersection_segments(line1, line2, right1, right2)) {
-        return SphereBoxSide::Right;
+    if (normal == glm::vec2(0.0f)) {
+        return false;  // Started inside the expanded box, but not overlapping the box
     }
 
-    // FIXME do physics in a separate update function
+    contact.time = time_enter;
+    contact.normal = glm::vec3(normal.x, 0.0f, normal.y);
 
-    assert(false);
-    return {};  // std::unreachable's only in c++23 :P
+    return true;
+}
+
+SphereBoxSide side_from_normal(glm::vec3 normal) {
+    if (glm::abs(normal.x) > glm::abs(normal.z)) {
+        return normal.x < 0.0f ? SphereBoxSide::Left : SphereBoxSide::Right;
+    } else {
+        return normal.z < 0.0f ? SphereBoxSide::Back : SphereBoxSide::Front;
+    }
 }
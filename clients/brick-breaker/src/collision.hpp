@@ -1,5 +1,9 @@
 #pragma once
 
+#include <vector>
+#include <cstddef>
+#include <cstdint>
+
 #include <glm/glm.hpp>
 
 struct Sphere {
@@ -14,6 +18,20 @@ struct Box {
     float depth {};  // z
 };
 
+// Many boxes stored as structure of arrays, for testing them in batches
+struct BoxArray {
+    void add(const Box& box);
+    void clear();
+    std::size_t size() const { return min_x.size(); }
+
+    std::vector<float> min_x;
+    std::vector<float> min_y;
+    std::vector<float> min_z;
+    std::vector<float> max_x;
+    std::vector<float> max_y;
+    std::vector<float> max_z;
+};
+
 enum class SphereBoxSide {
     Front,
     Back,
@@ -21,5 +39,17 @@ enum class SphereBoxSide {
     Right
 };
 
+struct Contact {
+    float time {};  // Fraction of the displacement, in [0, 1]
+    glm::vec3 normal {};  // Points from the box towards the sphere
+};
+
 bool collision_sphere_box(const Sphere& sphere, const Box& box);
 SphereBoxSide sphere_box_side_2d(const Sphere& sphere, const Box& box);
+
+// Set one bit in hits for every box that collides, using SIMD when available
+void collision_sphere_boxes(const Sphere& sphere, const BoxArray& boxes, std::vector<std::uint64_t>& hits);
+
+// Continuous collision of a sphere moving by displacement in the XZ plane, reporting only approaching contacts
+bool sweep_sphere_box(const Sphere& sphere, glm::vec3 displacement, const Box& box, Contact& contact);
+SphereBoxSide side_from_normal(glm::vec3 normal);
@@ -0,0 +1,17 @@
+#pragma once
+
+#include <glm/glm.hpp>
+
+// Position now and at the previous update, for rendering in between
+struct Transform {
+    glm::vec3 position {};
+    glm::vec3 previous_position {};
+};
+
+struct SphereCollider {
+    float radius {};
+};
+
+struct BoxCollider {
+    glm::vec3 extents {};  // Half the size
+};
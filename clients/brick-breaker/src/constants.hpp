@@ -23,3 +23,5 @@ inline constexpr float PADDLE_VELOCITY {13.0f};
 inline constexpr float BALL_RADIUS_NORMAL {0.3f};
 inline constexpr float BALL_RADIUS_FIRE {0.4f};
 inline constexpr float ORB_RATE {0.8f};
+inline constexpr int BALL_MAX_SUBSTEPS {8};
+inline constexpr float CONTACT_SKIN {0.001f};
@@ -1,24 +1,28 @@
 #pragma once
 
+#include <entt/entity/entity.hpp>
+
+#include "collision.hpp"
+
 struct BallPaddleCollisionEvent {
-    unsigned int ball_index {};
+    entt::entity ball {entt::null};
     SphereBoxSide side {};
 };
 
 struct BallMissEvent {
-    unsigned int ball_index {};
+    entt::entity ball {entt::null};
 };
 
 struct OrbMissEvent {
-    unsigned int orb_index {};
+    entt::entity orb {entt::null};
 };
 
 struct OrbPaddleCollisionEvent {
-    unsigned int orb_index {};
+    entt::entity orb {entt::null};
 };
 
 struct BallBrickCollisionEvent {
-    unsigned int ball_index {};
-    unsigned int brick_index {};
+    entt::entity ball {entt::null};
+    entt::entity brick {entt::null};
     SphereBoxSide side {};
 };
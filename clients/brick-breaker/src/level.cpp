@@ -1,13 +1,9 @@
 #include "level.hpp"
 
-#include <fstream>
-#include <utility>
+#include <string>
 #include <cassert>
 
 #include <glm/gtx/quaternion.hpp>
-#include <glm/gtx/rotate_vector.hpp>
-#include <glm/gtc/random.hpp>
-#include <nlohmann/json.hpp>
 
 #include "constants.hpp"
 #include "data.hpp"
@@ -24,10 +20,6 @@
 
 using namespace resmanager::literals;
 
-static constexpr float mapf(float x, float in_min, float in_max, float out_min, float out_max) {
-    return (x - in_min) * (out_max - out_min) / (in_max - in_min) + out_min;
-}
-
 void LevelScene::on_enter() {
     cam_controller = MyCameraController(
         &cam,
@@ -68,12 +60,6 @@ void LevelScene::on_enter() {
     connect_event<bb::MouseMovedEvent, &LevelScene::on_mouse_moved>(this);
     connect_event<bb::MouseButtonReleasedEvent, &LevelScene::on_mouse_button_released>(this);
 
-    connect_event<BallPaddleCollisionEvent, &LevelScene::on_ball_paddle_collision>(this);
-    connect_event<BallMissEvent, &LevelScene::on_ball_miss>(this);
-    connect_event<OrbMissEvent, &LevelScene::on_orb_miss>(this);
-    connect_event<OrbPaddleCollisionEvent, &LevelScene::on_orb_paddle_collision>(this);
-    connect_event<BallBrickCollisionEvent, &LevelScene::on_ball_brick_collision>(this);
-
     load_shaders();
     load_skybox();
     load_platform();
@@ -83,46 +69,50 @@ void LevelScene::on_enter() {
     load_lamp();
     load_orb();
 
+    get_registry().on_construct<Ball>().connect<&LevelScene::on_ball_constructed>(this);
+    get_registry().on_construct<Brick>().connect<&LevelScene::on_brick_constructed>(this);
+    get_registry().on_construct<Orb>().connect<&LevelScene::on_orb_constructed>(this);
+
     auto& data {user_data<Data>()};
 
     bb::OpenGl::clear_color(0.1f, 0.1f, 0.15f);
     skybox(cache_texture_cubemap["skybox"_H]);
     capture_mouse(data.mouse_input);
 
-    id_gen = IdGenerator();
-    paddle = Paddle();
+    input = GameInput();
 
-    balls.clear();
-    create_ball();
+    LevelDescription level;
 
-    bricks.clear();
-    auto level {load_level(data.selected_level, id_gen)};
-
-    if (!level) {
-        bb::log_message("Could not load level!\n");
+    if (level_prefetch.take(data.selected_level, level)) {
+        simulation.start(level, data.score, data.lives, get_random().next());
+        play_sound(data.sound_start);
+    } else if (!simulation.start(data.selected_level, data.score, data.lives, get_random().next())) {
+        BB_LOG_ERROR(Game, "Could not load level!\n");
         play_sound(data.sound_start_failure);
     } else {
-        bricks = std::move(*level);
         play_sound(data.sound_start);
     }
 
-    orbs.clear();
+    // Custom levels are played on their own, so there is something to read ahead only in the adventure
+    const bool adventure {
+        data.current_level < ADVENTURE_MAX && data.selected_level == ADVENTURE_LEVELS[data.current_level]
+    };
 
-    game_over = GameOver::None;
+    if (adventure && data.current_level + 1u < ADVENTURE_MAX) {
+        level_prefetch.prefetch(ADVENTURE_LEVELS[data.current_level + 1u]);
+    }
 }
 
 void LevelScene::on_exit() {
     skybox(nullptr);
+
+    get_registry().on_construct<Ball>().disconnect(this);
+    get_registry().on_construct<Brick>().disconnect(this);
+    get_registry().on_construct<Orb>().disconnect(this);
 }
 
 void LevelScene::on_update() {
-    if (arrows.left) {
-        paddle.velocity_x = -PADDLE_VELOCITY;
-    } else if (arrows.right) {
-        paddle.velocity_x = PADDLE_VELOCITY;
-    } else {
-        paddle.velocity_x = 0.0f;
-    }
+    BB_PROFILE_SCOPE("LevelScene::on_update");
 
     cam_controller.update_controls(get_delta());
     cam_controller.update_camera(get_delta());
@@ -134,24 +124,8 @@ void LevelScene::on_update() {
     add_light(lamp_right);
     shadows(-21.0f, 20.0f, -12.0f, 12.0f, 1.0f, 20.0f, directional_light.direction * -10.0f);
 
-    if (death_flag) {
-        die();
-        death_flag = false;
-    }
-
-    update_bricks();
-
-    update_paddle(paddle);
-
-    for (auto& [_, ball] : balls) {
-        update_ball(ball);
-    }
-
-    for (auto& [_, orb] : orbs) {
-        update_orb(orb);
-    }
-
-    update_collisions();
+    // Render in between the last two simulation states
+    const float alpha {get_interpolation_alpha()};
 
     {
         bb::Renderable r_platform;
@@ -161,74 +135,68 @@ void LevelScene::on_update() {
         add_renderable(r_platform);
     }
 
-    if (game_over == GameOver::None) {
+    const Paddle& paddle {simulation.get_paddle()};
+
+    if (simulation.get_game_over() == GameOver::None) {
         bb::Renderable r_paddle;
         r_paddle.vertex_array = cache_vertex_array["paddle"_H];
         r_paddle.material = cache_material_instance["paddle"_H];
-        r_paddle.position = paddle.get_position();
+        r_paddle.position = paddle.get_interpolated_position(alpha);
         r_paddle.rotation = paddle.get_rotation();
         r_paddle.scale = paddle.get_scale();
         add_renderable(r_paddle);
 
 #if SHOW_DEBUG_RENDERING
         Box b;
-        b.position = paddle.get_position();
+        b.position = paddle.get_interpolated_position(alpha);
         b.width = paddle.get_dimensions().x;
         b.height = paddle.get_dimensions().y;
         b.depth = paddle.get_dimensions().z;
         draw_bounding_box(b);
 #endif
+    }
+
+    // The renderables of balls, orbs and bricks are in the registry, only move them
+    get_registry().view<Transform, SphereCollider, Ball, bb::Renderable>().each([&](const Transform& transform, const SphereCollider& collider, const Ball& ball, bb::Renderable& r_ball) {
+        const glm::vec3 position {glm::mix(transform.previous_position, transform.position, alpha)};
 
-        for (const auto& [_, ball] : balls) {
-            bb::Renderable r_ball;
-            r_ball.vertex_array = cache_vertex_array["ball"_H];
-            r_ball.material = cache_material_instance["ball"_H];
-            r_ball.transformation = ball.transformation;
-            add_renderable(r_ball);
+        glm::mat4 trans {1.0f};
+        trans = glm::translate(trans, position);
+        trans *= glm::toMat4(ball.rotation);
+        trans = glm::scale(trans, glm::vec3(collider.radius));  // Default ball size should be 1 meter in radius, so radius is scale
+
+        r_ball.transformation = trans;
 
 #if SHOW_DEBUG_RENDERING
-            debug_add_line(ball.get_position() - glm::vec3(ball.radius, 0.0f, 0.0f), ball.get_position() + glm::vec3(ball.radius, 0.0f, 0.0f), GREEN);
-            debug_add_line(ball.get_position() - glm::vec3(0.0f, 0.0f, ball.radius), ball.get_position() + glm::vec3(0.0f, 0.0f, ball.radius), GREEN);
+        debug_add_line(position - glm::vec3(collider.radius, 0.0f, 0.0f), position + glm::vec3(collider.radius, 0.0f, 0.0f), GREEN);
+        debug_add_line(position - glm::vec3(0.0f, 0.0f, collider.radius), position + glm::vec3(0.0f, 0.0f, collider.radius), GREEN);
 #endif
-        }
+    });
 
-        for (const auto& [_, orb] : orbs) {
-            const auto material_id {resmanager::HashedStr64("orb" + std::to_string(static_cast<int>(orb.get_type())))};
+    get_registry().view<Transform, SphereCollider, Orb, bb::Renderable>().each([&](const Transform& transform, [[maybe_unused]] const SphereCollider& collider, const Orb&, bb::Renderable& r_orb) {
+        const glm::vec3 position {glm::mix(transform.previous_position, transform.position, alpha)};
 
-            bb::Renderable r_orb;
-            r_orb.vertex_array = cache_vertex_array["orb"_H];
-            r_orb.material = cache_material_instance[material_id];
-            r_orb.position = orb.position;
-            r_orb.scale = orb.radius;
-            add_renderable(r_orb);
+        r_orb.position = position;
 
 #if SHOW_DEBUG_RENDERING
-            debug_add_line(orb.position - glm::vec3(orb.radius, 0.0f, 0.0f), orb.position + glm::vec3(orb.radius, 0.0f, 0.0f), GREEN);
-            debug_add_line(orb.position - glm::vec3(0.0f, 0.0f, orb.radius), orb.position + glm::vec3(0.0f, 0.0f, orb.radius), GREEN);
+        debug_add_line(position - glm::vec3(collider.radius, 0.0f, 0.0f), position + glm::vec3(collider.radius, 0.0f, 0.0f), GREEN);
+        debug_add_line(position - glm::vec3(0.0f, 0.0f, collider.radius), position + glm::vec3(0.0f, 0.0f, collider.radius), GREEN);
 #endif
-        }
-    }
-
-    for (const auto& [_, brick] : bricks) {
-        const auto material_id {resmanager::HashedStr64("brick" + std::to_string(static_cast<int>(brick.get_type()) + 1))};
+    });
 
-        bb::Renderable r_brick;
-        r_brick.vertex_array = cache_vertex_array["brick"_H];
-        r_brick.material = cache_material_instance[material_id];
-        r_brick.position = brick.get_position();
-        r_brick.rotation = brick.get_rotation();
-        r_brick.scale = brick.get_scale();
-        add_renderable(r_brick);
+    // Bricks are not interpolated, as they only fall one cell at a time
+    get_registry().view<Transform, BoxCollider, Brick, bb::Renderable>().each([&](const Transform& transform, [[maybe_unused]] const BoxCollider& collider, const Brick&, bb::Renderable& r_brick) {
+        r_brick.position = transform.position;
 
 #if SHOW_DEBUG_RENDERING
         Box b;
-        b.position = brick.get_position();
-        b.width = brick.get_dimensions().x;
-        b.height = brick.get_dimensions().y;
-        b.depth = brick.get_dimensions().z;
+        b.position = transform.position;
+        b.width = collider.extents.x;
+        b.height = collider.extents.y;
+        b.depth = collider.extents.z;
         draw_bounding_box(b);
 #endif
-    }
+    });
 
     {
         bb::Renderable r_lamp;
@@ -284,10 +252,10 @@ void LevelScene::on_update() {
         add_text(text);
     }
 
-    if (game_over != GameOver::None) {
+    if (simulation.get_game_over() != GameOver::None) {
         const char* string {nullptr};
 
-        switch (game_over) {
+        switch (simulation.get_game_over()) {
             case GameOver::Lost:
                 string = "Game Over";
                 break;
@@ -329,6 +297,32 @@ void LevelScene::on_update() {
 #endif
 }
 
+void LevelScene::on_fixed_update() {
+    BB_PROFILE_SCOPE("LevelScene::on_fixed_update");
+
+    simulation.update(input, get_fixed_delta());
+
+    // These are consumed by the simulation
+    input.shoot = false;
+    input.paddle_movement = 0.0f;
+
+    auto& data {user_data<Data>()};
+
+    for (const GameEvent& event : simulation.get_events()) {
+        switch (event.type) {
+            case GameEvent::Type::Sound:
+                play_game_sound(event.sound);
+                break;
+            case GameEvent::Type::Score:
+                data.score += event.points;
+                break;
+            case GameEvent::Type::Lives:
+                data.lives += event.lives;
+                break;
+        }
+    }
+}
+
 void LevelScene::on_window_resized(const bb::WindowResizedEvent& event) {
     cam.set_projection_matrix(event.width, event.height, LENS_FOV, LENS_NEAR, LENS_FAR);
     cam_2d.set_projection_matrix(0.0f, static_cast<float>(event.width), 0.0f, static_cast<float>(event.height));
@@ -338,10 +332,10 @@ void LevelScene::on_key_pressed(const bb::KeyPressedEvent& event) {
     if (!event.repeat) {
         switch (event.key) {
             case bb::KeyCode::K_LEFT:
-                arrows.left = true;
+                input.left = true;
                 break;
             case bb::KeyCode::K_RIGHT:
-                arrows.right = true;
+                input.right = true;
                 break;
             default:
                 break;
@@ -352,16 +346,16 @@ void LevelScene::on_key_pressed(const bb::KeyPressedEvent& event) {
 void LevelScene::on_key_released(const bb::KeyReleasedEvent& event) {
     switch (event.key) {
         case bb::KeyCode::K_LEFT:
-            arrows.left = false;
+            input.left = false;
             break;
         case bb::KeyCode::K_RIGHT:
-            arrows.right = false;
+            input.right = false;
             break;
         case bb::KeyCode::K_SPACE:
-            if (game_over == GameOver::Won) {
+            if (simulation.get_game_over() == GameOver::Won) {
                 next_level();
             } else {
-                shoot_balls();
+                input.shoot = true;
             }
 
             break;
@@ -385,7 +379,7 @@ void LevelScene::on_mouse_moved(const bb::MouseMovedEvent& event) {
         return;
     }
 
-    paddle.set_position(paddle.get_position().x + event.xrel * 0.9f * get_delta());
+    input.paddle_movement += event.xrel * 0.9f * get_delta();
 }
 
 void LevelScene::on_mouse_button_released(const bb::MouseButtonReleasedEvent& event) {
@@ -393,10 +387,10 @@ void LevelScene::on_mouse_button_released(const bb::MouseButtonReleasedEvent& ev
 
     if (data.mouse_input) {
         if (event.button == bb::MB_LEFT_ENUM) {
-            if (game_over == GameOver::Won) {
+            if (simulation.get_game_over() == GameOver::Won) {
                 next_level();
             } else {
-                shoot_balls();
+                input.shoot = true;
             }
         }
     }
@@ -407,6 +401,35 @@ void LevelScene::on_mouse_button_released(const bb::MouseButtonReleasedEvent& ev
     }
 }
 
+void LevelScene::on_ball_constructed(entt::registry& registry, entt::entity entity) {
+    bb::Renderable& r_ball {registry.emplace<bb::Renderable>(entity)};
+    r_ball.vertex_array = cache_vertex_array["ball"_H];
+    r_ball.material = cache_material_instance["ball"_H];
+}
+
+void LevelScene::on_brick_constructed(entt::registry& registry, entt::entity entity) {
+    const Brick& brick {registry.get<Brick>(entity)};
+    const auto material_id {resmanager::HashedStr64("brick" + std::to_string(static_cast<int>(brick.type) + 1))};
+
+    bb::Renderable& r_brick {registry.emplace<bb::Renderable>(entity)};
+    r_brick.vertex_array = cache_vertex_array["brick"_H];
+    r_brick.material = cache_material_instance[material_id];
+    r_brick.position = registry.get<Transform>(entity).position;
+    r_brick.rotation = brick.rotation;
+    r_brick.scale = Brick::get_scale();
+}
+
+void LevelScene::on_orb_constructed(entt::registry& registry, entt::entity entity) {
+    const Orb& orb {registry.get<Orb>(entity)};
+    const auto material_id {resmanager::HashedStr64("orb" + std::to_string(static_cast<int>(orb.type)))};
+
+    bb::Renderable& r_orb {registry.emplace<bb::Renderable>(entity)};
+    r_orb.vertex_array = cache_vertex_array["orb"_H];
+    r_orb.material = cache_material_instance[material_id];
+    r_orb.position = registry.get<Transform>(entity).position;
+    r_orb.scale = registry.get<SphereCollider>(entity).radius;
+}
+
 void LevelScene::load_shaders() {
 #if 0
     {
@@ -809,240 +832,6 @@ void LevelScene::load_orb() {
     }
 }
 
-void LevelScene::update_collisions() {
-    for (auto& [index, ball] : balls) {
-        Sphere s;
-        s.position = ball.get_position();
-        s.radius = ball.radius;
-
-        Box b;
-        b.position = paddle.get_position();
-        b.width = paddle.get_dimensions().x;
-        b.height = paddle.get_dimensions().y;
-        b.depth = paddle.get_dimensions().z;
-
-        if (collision_sphere_box(s, b)) {
-            bb::log_message("Collided!\n");
-
-            const SphereBoxSide side {sphere_box_side_2d(s, b)};
-
-            enqueue_event<BallPaddleCollisionEvent>(index, side);
-        }
-    }
-
-    for (const auto& [ball_index, ball] : balls) {
-        for (const auto& [brick_index, brick] : bricks) {
-            Sphere s;
-            s.position = ball.get_position();
-            s.radius = ball.radius;
-
-            Box b;
-            b.position = brick.get_position();
-            b.width = brick.get_dimensions().x;
-            b.height = brick.get_dimensions().y;
-            b.depth = brick.get_dimensions().z;
-
-            if (collision_sphere_box(s, b)) {
-                bb::log_message("Collided!\n");
-
-                const SphereBoxSide side {sphere_box_side_2d(s, b)};
-
-                enqueue_event<BallBrickCollisionEvent>(ball_index, brick_index, side);
-            }
-        }
-    }
-
-    for (auto& [index, orb] : orbs) {
-        Sphere s;
-        s.position = orb.position;
-        s.radius = orb.radius;
-
-        Box b;
-        b.position = paddle.get_position();
-        b.width = paddle.get_dimensions().x;
-        b.height = paddle.get_dimensions().y;
-        b.depth = paddle.get_dimensions().z;
-
-        if (collision_sphere_box(s, b)) {
-            bb::log_message("Collided!\n");
-
-            enqueue_event<OrbPaddleCollisionEvent>(index);
-        }
-    }
-}
-
-void LevelScene::update_bricks() {
-    for (auto& [_, brick] : bricks) {
-        if (brick.get_grid().y == 0) {
-            continue;
-        }
-
-        for (const auto& [_, brick_below] : bricks) {
-            // Check if there is a brick below
-            if (brick_below.get_grid().y == brick.get_grid().y - 1) {
-                if (brick_below.get_grid().x == brick.get_grid().x && brick_below.get_grid().z == brick.get_grid().z) {
-                    goto continue_outer;
-                }
-            }
-        }
-
-        // This brick is in the air :P
-        brick.lower_grid();
-        brick.set_position(brick.get_grid());
-
-        continue_outer:
-        continue;
-    }
-}
-
-void LevelScene::update_paddle(Paddle& paddle) {
-    paddle.set_position(paddle.get_position().x + paddle.velocity_x * get_delta());
-
-    static constexpr float min {PLATFORM_EDGE_MIN_X + 0.7f};
-    static constexpr float max {PLATFORM_EDGE_MAX_X - 0.7f};
-
-    if (paddle.get_position().x < min) {
-        paddle.set_position(min);
-    }
-
-    if (paddle.get_position().x > max) {
-        paddle.set_position(max);
-    }
-}
-
-void LevelScene::update_orb(Orb& orb) {
-    orb.position += orb.velocity * get_delta();
-
-    if (orb.position.z > DEADLINE_Z) {
-        enqueue_event<OrbMissEvent>(orb.get_index());
-    }
-}
-
-void LevelScene::update_ball(Ball& ball) {
-    ball.set_position_x((ball.get_position() + ball.velocity * get_delta()).x);
-    ball.set_position_z((ball.get_position() + ball.velocity * get_delta()).z);
-
-    if (ball.attached_to_paddle) {
-        // Override position
-        ball.set_position_x(paddle.get_position().x);
-        ball.set_position_z(paddle.get_position().z - 1.0f);
-    }
-
-    const auto perpendicular_velocity {glm::rotate(glm::normalize(ball.velocity), glm::radians(90.0f), glm::vec3(0.0f, 1.0f, 0.0f))};
-    const float current_rotation {rotate_ball(ball)};
-
-    glm::mat4 trans {1.0f};
-    trans = glm::translate(trans, ball.get_position());
-    trans *= glm::toMat4(ball.rotation);
-    trans = glm::rotate(trans, current_rotation, perpendicular_velocity);
-    trans = glm::scale(trans, glm::vec3(ball.radius));  // Default ball size should be 1 meter in radius, so radius is scale
-
-    ball.transformation = trans;
-
-    const glm::quat rot {glm::angleAxis(current_rotation, perpendicular_velocity)};
-    ball.rotation = rot * ball.rotation;
-
-    auto& data {user_data<Data>()};
-
-    if (ball.get_position().x > PLATFORM_EDGE_MAX_X - ball.radius) {
-        ball.set_position_x(PLATFORM_EDGE_MAX_X - ball.radius);
-        ball.velocity.x *= -1.0f;
-
-        play_sound(data.sound_collision_wall);
-    }
-
-    if (ball.get_position().x < PLATFORM_EDGE_MIN_X + ball.radius) {
-        ball.set_position_x(PLATFORM_EDGE_MIN_X + ball.radius);
-        ball.velocity.x *= -1.0f;
-
-        play_sound(data.sound_collision_wall);
-    }
-
-    if (ball.get_position().z < PLATFORM_EDGE_MIN_Z + ball.radius) {
-        ball.set_position_z(PLATFORM_EDGE_MIN_Z + ball.radius);
-        ball.velocity.z *= -1.0f;
-
-        play_sound(data.sound_collision_wall);
-    }
-
-    if (ball.get_position().z > DEADLINE_Z) {
-        enqueue_event<BallMissEvent>(ball.get_index());
-    }
-}
-
-void LevelScene::shoot_balls() {
-    bool any_ball {false};
-
-    for (auto& [_, ball] : balls) {
-        if (ball.attached_to_paddle) {
-            const auto vector {glm::vec3(glm::linearRand(-5.0f, 5.0f), 0.0f, -5.0f)};
-            const auto direction {glm::normalize(vector)};
-
-            ball.velocity = direction * SHOOT_VELOCITY;
-            ball.attached_to_paddle = false;
-
-            any_ball = true;
-        }
-    }
-
-    if (any_ball) {
-        auto& data {user_data<Data>()};
-        play_sound(data.sound_collision_paddle);
-    }
-}
-
-void LevelScene::create_ball() {
-    const auto index {id_gen.generate()};
-    balls[index] = Ball(index);
-}
-
-void LevelScene::spawn_orb(glm::vec3 position) {
-    const auto velocity {glm::vec3(0.0f, 0.0f, glm::linearRand(5.0f, 7.0f))};
-    const float random_type {glm::linearRand(static_cast<float>(OrbType::FIRST), static_cast<float>(OrbType::LAST) + 1.0f)};
-
-    const auto index {id_gen.generate()};
-    orbs[index] = Orb(index, position.x, position.z, velocity, static_cast<OrbType>(static_cast<int>(random_type)));
-
-    bb::log_message("Spawned orb\n");
-}
-
-void LevelScene::win() {
-    game_over = GameOver::Won;
-    balls.clear();
-    orbs.clear();
-
-    auto& data {user_data<Data>()};
-    play_sound(data.sound_won);
-
-    bb::log_message("Congratulations!\n");
-}
-
-void LevelScene::lose() {
-    game_over = GameOver::Lost;
-    // Balls and orbs are already cleared
-
-    auto& data {user_data<Data>()};
-    play_sound(data.sound_lost);
-
-    bb::log_message("Game over!\n");
-}
-
-void LevelScene::die() {
-    auto& data {user_data<Data>()};
-    play_sound(data.sound_die);
-
-    data.lives--;
-    balls.clear();
-    orbs.clear();
-
-    if (data.lives == 0) {
-        lose();
-    } else {
-        paddle = Paddle();
-        create_ball();
-    }
-}
-
 void LevelScene::reset() {
     auto& data {user_data<Data>()};
 
@@ -1064,231 +853,31 @@ void LevelScene::next_level() {
     change_scene("level");
 }
 
-std::optional<std::unordered_map<unsigned int, Brick>> LevelScene::load_level(const std::string& file_path, IdGenerator& gen) {
-    std::ifstream file {file_path};
-
-    if (!file.is_open()) {
-        return std::nullopt;
-    }
-
-    std::unordered_map<unsigned int, Brick> result;
-
-    const nlohmann::json root = nlohmann::json::parse(file);
-
-    try {
-        const nlohmann::json& j_bricks {root["bricks"].get<nlohmann::json>()};
-
-        for (const nlohmann::json& j_brick : j_bricks) {
-            const nlohmann::json& position {j_brick["position"].get<nlohmann::json>()};
-            const int type {j_brick["type"].get<int>()};
-
-            if (position.size() != 3u) {
-                return std::nullopt;
-            }
-
-            const int x {position[0].get<int>()};
-            const int y {position[1].get<int>()};
-            const int z {position[2].get<int>()};
-
-            if (x < BRICKS_GRID_MIN_X || x > BRICKS_GRID_MAX_X) {
-                return std::nullopt;
-            }
-
-            if (z < BRICKS_GRID_MIN_Z || z > BRICKS_GRID_MAX_Z) {
-                return std::nullopt;
-            }
-
-            if (y < BRICKS_GRID_MIN_Y || y > BRICKS_GRID_MAX_Y) {
-                return std::nullopt;
-            }
-
-            if (type < static_cast<int>(BrickType::FIRST) || type > static_cast<int>(BrickType::LAST)) {
-                return std::nullopt;
-            }
-
-            const auto index {gen.generate()};
-            const bool rot_y {glm::linearRand(0.0f, 1.0f) > 0.5f};
-            const bool rot_z {glm::linearRand(0.0f, 1.0f) > 0.5f};
-
-            result[index] = Brick(index, glm::ivec3(x, y, z), rot_y, rot_z, static_cast<BrickType>(type));
-        }
-    } catch (const nlohmann::json::exception&) {
-        return std::nullopt;
-    }
-
-    return std::make_optional(result);
-}
-
-glm::vec2 LevelScene::bounce_ball_off_paddle(const Ball& ball) {
-    // https://www.mathsisfun.com/polar-cartesian-coordinates.html
-
-    const float original_velocity {glm::length(ball.velocity)};
-
-    const float distance {glm::abs(paddle.get_position().x - ball.get_position().x)};
-    const float theta {mapf(distance, 0.0f, paddle.get_dimensions().x, 0.0f, 70.0f)};
-
-    const float directed_theta {paddle.get_position().x - ball.get_position().x > 0.0f ? theta + 90.0f : -theta + 90.0f};
-
-    return glm::vec2(original_velocity * glm::cos(glm::radians(directed_theta)), original_velocity * glm::sin(glm::radians(directed_theta)));
-}
-
-float LevelScene::rotate_ball(const Ball& ball) {
-    const float velocity {glm::length(ball.velocity) * get_delta()};
-    const float half_diameter {glm::pi<float>() * ball.radius};
-    const float theta {velocity / half_diameter};  // Radians
-
-    return theta;
-}
-
-void LevelScene::on_ball_paddle_collision(const BallPaddleCollisionEvent& event) {
-    if (balls.find(event.ball_index) != balls.end()) {
-        Ball& ball {balls.at(event.ball_index)};
-
-        switch (event.side) {
-            case SphereBoxSide::Back: {
-                const auto velocity {bounce_ball_off_paddle(ball)};
-
-                ball.set_position_z(paddle.get_position().z - paddle.get_dimensions().z - ball.radius);
-                ball.velocity.z = -velocity.y;
-                ball.velocity.x = velocity.x;
-
-                break;
-            }
-            case SphereBoxSide::Left:
-                ball.set_position_x(paddle.get_position().x - paddle.get_dimensions().x - ball.radius);
-                ball.velocity.x *= -1;
-                break;
-            case SphereBoxSide::Right:
-                ball.set_position_x(paddle.get_position().x + paddle.get_dimensions().x + ball.radius);
-                ball.velocity.x *= -1;
-                break;
-            default:
-                break;
-        }
-    }
-
+void LevelScene::play_game_sound(Sound sound) {
     auto& data {user_data<Data>()};
-    play_sound(data.sound_collision_paddle);
-}
-
-void LevelScene::on_ball_miss(const BallMissEvent& event) {
-    if (balls.find(event.ball_index) != balls.end()) {
-        balls.erase(event.ball_index);
-
-        if (balls.empty()) {
-            death_flag = true;
-        }
-    }
-}
-
-void LevelScene::on_orb_miss(const OrbMissEvent& event) {
-    if (orbs.find(event.orb_index) != orbs.end()) {
-        orbs.erase(event.orb_index);
-    }
-}
-
-void LevelScene::on_orb_paddle_collision(const OrbPaddleCollisionEvent& event) {
-    if (orbs.find(event.orb_index) != orbs.end()) {
-        Orb& orb {orbs.at(event.orb_index)};
-
-        auto& data {user_data<Data>()};
-        play_sound(data.sound_switch);
-
-        data.score += orb.get_points();
-
-        switch (orb.get_type()) {
-            case OrbType::SpeedUp:
-                for (auto& [_, ball] : balls) {
-                    ball.velocity *= 1.25f;
-                }
-
-                break;
-            case OrbType::SpeedDown:
-                for (auto& [_, ball] : balls) {
-                    ball.velocity *= 0.8f;
-                }
-
-                break;
-            case OrbType::ExtraLife:
-                data.lives++;
-
-                break;
-            case OrbType::Die:
-                death_flag = true;
-
-                break;
-            case OrbType::FireBall:
-                for (auto& [_, ball] : balls) {
-                    ball.fire = true;
-                    ball.radius = BALL_RADIUS_FIRE;
-                }
-
-                break;
-            case OrbType::NormalBall:
-                for (auto& [_, ball] : balls) {
-                    ball.fire = false;
-                    ball.radius = BALL_RADIUS_NORMAL;
-                }
 
-                break;
-            case OrbType::ExtraBall:
-                create_ball();
-
-                break;
-            default:
-                break;
-        }
-
-        orbs.erase(event.orb_index);
-    }
-}
-
-void LevelScene::on_ball_brick_collision(const BallBrickCollisionEvent& event) {
-    if (balls.find(event.ball_index) == balls.end()) {
-        return;
-    }
-
-    Ball& ball {balls.at(event.ball_index)};
-
-    if (bricks.find(event.brick_index) != bricks.end()) {
-        const Brick& brick {bricks.at(event.brick_index)};
-
-        if (!ball.fire) {
-            switch (event.side) {
-                case SphereBoxSide::Front:
-                    ball.set_position_z(brick.get_position().z + brick.get_dimensions().z + ball.radius);
-                    ball.velocity.z *= -1.0f;
-                    break;
-                case SphereBoxSide::Back:
-                    ball.set_position_z(brick.get_position().z - brick.get_dimensions().z - ball.radius);
-                    ball.velocity.z *= -1.0f;
-                    break;
-                case SphereBoxSide::Left:
-                    ball.set_position_x(brick.get_position().x - brick.get_dimensions().x - ball.radius);
-                    ball.velocity.x *= -1.0f;
-                    break;
-                case SphereBoxSide::Right:
-                    ball.set_position_x(brick.get_position().x + brick.get_dimensions().x + ball.radius);
-                    ball.velocity.x *= -1.0f;
-                    break;
-            }
-        }
-
-        auto& data {user_data<Data>()};
-
-        data.score += brick.get_points();
-
-        play_sound(data.sound_collision_brick);
-
-        if (glm::linearRand(0.0f, 1.0f) > ORB_RATE) {
-            spawn_orb(brick.get_position());
-        }
-
-        bricks.erase(event.brick_index);
-
-        if (bricks.empty()) {
-            win();
-        }
+    switch (sound) {
+        case Sound::CollisionBrick:
+            play_sound(data.sound_collision_brick);
+            break;
+        case Sound::CollisionPaddle:
+            play_sound(data.sound_collision_paddle);
+            break;
+        case Sound::CollisionWall:
+            play_sound(data.sound_collision_wall);
+            break;
+        case Sound::Die:
+            play_sound(data.sound_die);
+            break;
+        case Sound::Lost:
+            play_sound(data.sound_lost);
+            break;
+        case Sound::Won:
+            play_sound(data.sound_won);
+            break;
+        case Sound::Switch:
+            play_sound(data.sound_switch);
+            break;
     }
 }
 
@@ -1317,9 +906,12 @@ void LevelScene::draw_bounding_box(const Box& box) {
 void LevelScene::draw_fps() {
     auto& data {user_data<Data>()};
 
+    // The average hides stutter, so show the slowest frames too
+    const bb::FrameStatisticsSummary summary {get_frame_statistics().calculate()};
+
     bb::Text text;
     text.font = data.basic_font;
-    text.string = std::to_string(get_fps()) + " FPS, " + std::to_string(get_delta()) + " ms";
+    text.string = std::to_string(get_fps()) + " FPS, p99 " + std::to_string(summary.p99) + " ms";
     text.position = glm::vec2(2.0f, 2.0f);
     text.color = glm::vec3(0.9f);
     text.scale = 0.3f;
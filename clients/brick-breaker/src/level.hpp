@@ -1,29 +1,22 @@
 #pragma once
 
-#include <unordered_map>
-#include <string>
-#include <optional>
-
 #include <engine/engine.hpp>
 #include <resmanager/resmanager.hpp>
 #include <glm/glm.hpp>
 
 #include "my_camera_controller.hpp"
 #include "collision.hpp"
-#include "paddle.hpp"
-#include "ball.hpp"
-#include "brick.hpp"
-#include "orb.hpp"
-#include "events.hpp"
-#include "id_generator.hpp"
+#include "simulation.hpp"
+#include "level_prefetch.hpp"
 
 struct LevelScene : public bb::Scene {
     LevelScene()
-        : bb::Scene("level") {}
+        : bb::Scene("level"), simulation(get_registry()) {}
 
     virtual void on_enter() override;
     virtual void on_exit() override;
     virtual void on_update() override;
+    virtual void on_fixed_update() override;
 
     void on_window_resized(const bb::WindowResizedEvent& event);
     void on_key_pressed(const bb::KeyPressedEvent& event);
@@ -31,6 +24,11 @@ struct LevelScene : public bb::Scene {
     void on_mouse_moved(const bb::MouseMovedEvent& event);
     void on_mouse_button_released(const bb::MouseButtonReleasedEvent& event);
 
+    // Give the entities of the simulation something to be rendered with
+    void on_ball_constructed(entt::registry& registry, entt::entity entity);
+    void on_brick_constructed(entt::registry& registry, entt::entity entity);
+    void on_orb_constructed(entt::registry& registry, entt::entity entity);
+
     void load_shaders();
     void load_skybox();
     void load_platform();
@@ -40,27 +38,9 @@ struct LevelScene : public bb::Scene {
     void load_lamp();
     void load_orb();
 
-    void update_collisions();
-    void update_bricks();
-    void update_paddle(Paddle& paddle);
-    void update_orb(Orb& orb);
-    void update_ball(Ball& ball);
-    void shoot_balls();
-    void create_ball();
-    void spawn_orb(glm::vec3 position);
-    void win();
-    void lose();
-    void die();  // Should be called only once per frame
     void reset();
     void next_level();
-    static std::optional<std::unordered_map<unsigned int, Brick>> load_level(const std::string& file_path, IdGenerator& gen);
-    glm::vec2 bounce_ball_off_paddle(const Ball& ball);
-    float rotate_ball(const Ball& ball);
-    void on_ball_paddle_collision(const BallPaddleCollisionEvent& event);
-    void on_ball_miss(const BallMissEvent& event);
-    void on_orb_miss(const OrbMissEvent& event);
-    void on_orb_paddle_collision(const OrbPaddleCollisionEvent& event);
-    void on_ball_brick_collision(const BallBrickCollisionEvent& event);
+    void play_game_sound(Sound sound);
 
     void draw_bounding_box(const Box& box);
     void draw_fps();
@@ -73,25 +53,13 @@ struct LevelScene : public bb::Scene {
     bb::PointLight lamp_left;
     bb::PointLight lamp_right;
 
-    IdGenerator id_gen;
-
-    Paddle paddle;
-    std::unordered_map<unsigned int, Ball> balls;
-    std::unordered_map<unsigned int, Brick> bricks;
-    std::unordered_map<unsigned int, Orb> orbs;
-
-    bool death_flag {false};
+    GameSimulation simulation;
 
-    enum class GameOver {
-        None,
-        Lost,
-        Won
-    } game_over {};
+    // The next adventure level is read while this one is played
+    LevelPrefetch level_prefetch;
 
-    struct {
-        bool left {false};
-        bool right {false};
-    } arrows;
+    // Accumulated in between simulation updates
+    GameInput input;
 
     // Caches to easily store these resources
     resmanager::Cache<bb::VertexArray> cache_vertex_array;
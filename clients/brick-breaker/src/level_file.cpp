@@ -0,0 +1,195 @@
+#include "level_file.hpp"
+
+#include <fstream>
+#include <filesystem>
+#include <system_error>
+#include <cstring>
+
+#include <nlohmann/json.hpp>
+
+#include "constants.hpp"
+
+static bool fail(std::string* error, const std::string& message) {
+    if (error != nullptr) {
+        *error = message;
+    }
+
+    return false;
+}
+
+bool parse_level_json(const std::string& file_path, LevelDescription& level, std::string* error) {
+    std::ifstream file {file_path};
+
+    if (!file.is_open()) {
+        return fail(error, "could not open file");
+    }
+
+    level = LevelDescription();
+
+    try {
+        const nlohmann::json root = nlohmann::json::parse(file);
+
+        level.name = root["name"].get<std::string>();
+
+        const nlohmann::json& j_bricks {root["bricks"].get<nlohmann::json>()};
+
+        for (const nlohmann::json& j_brick : j_bricks) {
+            const nlohmann::json& position {j_brick["position"].get<nlohmann::json>()};
+            const int type {j_brick["type"].get<int>()};
+
+            if (position.size() != 3u) {
+                return fail(error, "brick position must have three components");
+            }
+
+            const int x {position[0].get<int>()};
+            const int y {position[1].get<int>()};
+            const int z {position[2].get<int>()};
+
+            if (x < BRICKS_GRID_MIN_X || x > BRICKS_GRID_MAX_X) {
+                return fail(error, "brick x position out of bounds");
+            }
+
+            if (z < BRICKS_GRID_MIN_Z || z > BRICKS_GRID_MAX_Z) {
+                return fail(error, "brick z position out of bounds");
+            }
+
+            if (y < BRICKS_GRID_MIN_Y || y > BRICKS_GRID_MAX_Y) {
+                return fail(error, "brick y position out of bounds");
+            }
+
+            if (type < static_cast<int>(BrickType::FIRST) || type > static_cast<int>(BrickType::LAST)) {
+                return fail(error, "invalid brick type");
+            }
+
+            LevelFileBrick brick;
+            brick.x = static_cast<std::int8_t>(x);
+            brick.y = static_cast<std::int8_t>(y);
+            brick.z = static_cast<std::int8_t>(z);
+            brick.type = static_cast<std::uint8_t>(type);
+
+            level.bricks.push_back(brick);
+        }
+    } catch (const nlohmann::json::exception& e) {
+        return fail(error, e.what());
+    }
+
+    return true;
+}
+
+bool write_compiled_level(const std::string& file_path, const LevelDescription& level) {
+    std::ofstream file {file_path, std::ios::binary | std::ios::trunc};
+
+    if (!file.is_open()) {
+        return false;
+    }
+
+    LevelFileHeader header;
+    std::strncpy(header.name, level.name.c_str(), sizeof(header.name) - 1);
+    header.brick_count = static_cast<std::uint32_t>(level.bricks.size());
+
+    file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    file.write(reinterpret_cast<const char*>(level.bricks.data()), static_cast<std::streamsize>(level.bricks.size() * sizeof(LevelFileBrick)));
+
+    return static_cast<bool>(file);
+}
+
+bool read_level(const std::string& file_path, LevelDescription& level) {
+    if (is_compiled_level_fresh(file_path)) {
+        CompiledLevel compiled_level;
+
+        if (compiled_level.open(get_compiled_level_path(file_path))) {
+            level = LevelDescription();
+            level.name = compiled_level.get_name();
+            level.bricks.reserve(compiled_level.get_brick_count());
+
+            for (std::size_t i {0}; i < compiled_level.get_brick_count(); i++) {
+                const LevelFileBrick brick {compiled_level.get_brick(i)};
+
+                if (!is_brick_valid(brick)) {
+                    return false;
+                }
+
+                level.bricks.push_back(brick);
+            }
+
+            return true;
+        }
+    }
+
+    return parse_level_json(file_path, level);
+}
+
+std::string get_compiled_level_path(const std::string& file_path) {
+    return std::filesystem::path(file_path).replace_extension(COMPILED_LEVEL_EXTENSION).string();
+}
+
+bool is_compiled_level_fresh(const std::string& file_path) {
+    std::error_code ec;
+
+    const auto compiled_time {std::filesystem::last_write_time(get_compiled_level_path(file_path), ec)};
+
+    if (ec) {
+        return false;
+    }
+
+    const auto time {std::filesystem::last_write_time(file_path, ec)};
+
+    // Only the compiled level may be shipped
+    if (ec) {
+        return true;
+    }
+
+    return compiled_time >= time;
+}
+
+bool is_brick_valid(const LevelFileBrick& brick) {
+    if (brick.x < BRICKS_GRID_MIN_X || brick.x > BRICKS_GRID_MAX_X) {
+        return false;
+    }
+
+    if (brick.y < BRICKS_GRID_MIN_Y || brick.y > BRICKS_GRID_MAX_Y) {
+        return false;
+    }
+
+    if (brick.z < BRICKS_GRID_MIN_Z || brick.z > BRICKS_GRID_MAX_Z) {
+        return false;
+    }
+
+    return brick.type <= static_cast<std::uint8_t>(BrickType::LAST);
+}
+
+bool CompiledLevel::open(const std::string& file_path) {
+    if (!file.open(file_path)) {
+        return false;
+    }
+
+    if (file.get_size() < sizeof(LevelFileHeader)) {
+        file.close();
+        return false;
+    }
+
+    std::memcpy(&header, file.get_data(), sizeof(LevelFileHeader));
+
+    const LevelFileHeader expected;
+
+    if (std::memcmp(header.magic, expected.magic, sizeof(header.magic)) != 0 || header.version != expected.version) {
+        file.close();
+        return false;
+    }
+
+    if (file.get_size() != sizeof(LevelFileHeader) + header.brick_count * sizeof(LevelFileBrick)) {
+        file.close();
+        return false;
+    }
+
+    header.name[sizeof(header.name) - 1] = '\0';
+
+    return true;
+}
+
+LevelFileBrick CompiledLevel::get_brick(std::size_t index) const {
+    LevelFileBrick brick;
+    std::memcpy(&brick, file.get_data() + sizeof(LevelFileHeader) + index * sizeof(LevelFileBrick), sizeof(LevelFileBrick));
+
+    return brick;
+}
@@ -0,0 +1,75 @@
+#pragma once
+
+#include <string>
+#include <vector>
+#include <cstddef>
+#include <cstdint>
+
+#include <glm/glm.hpp>
+
+#include "brick.hpp"
+#include "mapped_file.hpp"
+
+/*
+    Levels are written in JSON and compiled by bb-levelc into a packed binary file next to the JSON one, which is
+    mapped into memory and read without any parsing:
+
+    LevelFileHeader
+    LevelFileBrick[brick_count]
+
+    Everything is in the native byte order of the machine that compiled the level, which is not checked.
+*/
+
+inline constexpr const char* COMPILED_LEVEL_EXTENSION {".bblevel"};
+
+struct LevelFileHeader {
+    char magic[4] {'B', 'B', 'L', 'V'};
+    std::uint32_t version {1u};
+    char name[64] {};  // Null terminated
+    std::uint32_t brick_count {0u};
+};
+
+struct LevelFileBrick {
+    std::int8_t x {};
+    std::int8_t y {};
+    std::int8_t z {};
+    std::uint8_t type {};
+};
+
+static_assert(sizeof(LevelFileHeader) == 76);
+static_assert(sizeof(LevelFileBrick) == 4);
+
+struct LevelDescription {
+    std::string name;
+    std::vector<LevelFileBrick> bricks;
+};
+
+// Parse and validate a level in JSON, storing the reason in error, if it's invalid
+bool parse_level_json(const std::string& file_path, LevelDescription& level, std::string* error = nullptr);
+
+bool write_compiled_level(const std::string& file_path, const LevelDescription& level);
+
+// Read a level from its compiled version, if it's fresh, or else from the JSON
+bool read_level(const std::string& file_path, LevelDescription& level);
+
+// Where the compiled version of a JSON level is
+std::string get_compiled_level_path(const std::string& file_path);
+
+// Check if the compiled level exists and is not older than the JSON one
+bool is_compiled_level_fresh(const std::string& file_path);
+
+bool is_brick_valid(const LevelFileBrick& brick);
+
+// A compiled level mapped into memory
+class CompiledLevel {
+public:
+    // Return false if the file is missing or invalid
+    bool open(const std::string& file_path);
+
+    const char* get_name() const { return header.name; }
+    std::size_t get_brick_count() const { return header.brick_count; }
+    LevelFileBrick get_brick(std::size_t index) const;
+private:
+    MappedFile file;
+    LevelFileHeader header;
+};
@@ -0,0 +1,230 @@
+#include "level_index.hpp"
+
+#include <unordered_map>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <algorithm>
+#include <system_error>
+#include <utility>
+
+#include "level_file.hpp"
+
+/*
+    The index file is text, one level per line, with the fields separated by tabs:
+
+    file name, modified time, size, valid, brick count, level name
+*/
+
+static constexpr const char* INDEX_HEADER {"bb-level-index 1"};
+
+static std::unordered_map<std::string, LevelIndexEntry> load_index(const std::filesystem::path& index_path) {
+    std::unordered_map<std::string, LevelIndexEntry> result;
+
+    std::ifstream file {index_path};
+
+    if (!file.is_open()) {
+        return result;
+    }
+
+    std::string line;
+
+    if (!std::getline(file, line) || line != INDEX_HEADER) {
+        return result;
+    }
+
+    while (std::getline(file, line)) {
+        std::istringstream stream {line};
+
+        LevelIndexEntry entry;
+        std::string file_name;
+        int valid {0};
+
+        std::getline(stream, file_name, '\t');
+        stream >> entry.modified_time >> entry.size >> valid >> entry.brick_count;
+        stream.ignore(1);  // Tab
+        std::getline(stream, entry.name);
+
+        if (!stream && !stream.eof()) {
+            continue;
+        }
+
+        entry.valid = valid != 0;
+        result[file_name] = std::move(entry);
+    }
+
+    return result;
+}
+
+static void save_index(const std::filesystem::path& index_path, const std::vector<std::pair<std::string, LevelIndexEntry>>& entries) {
+    // Write the whole index and replace the old one at once
+    std::filesystem::path temporary_path {index_path};
+    temporary_path += ".tmp";
+
+    {
+        std::ofstream file {temporary_path, std::ios::trunc};
+
+        if (!file.is_open()) {
+            return;
+        }
+
+        file << INDEX_HEADER << '\n';
+
+        for (const auto& [file_name, entry] : entries) {
+            file << file_name << '\t'
+                << entry.modified_time << '\t'
+                << entry.size << '\t'
+                << static_cast<int>(entry.valid) << '\t'
+                << entry.brick_count << '\t'
+                << entry.name << '\n';
+        }
+    }
+
+    std::error_code ec;
+    std::filesystem::rename(temporary_path, index_path, ec);
+}
+
+static void read_entry(LevelIndexEntry& entry) {
+    if (is_compiled_level_fresh(entry.file_path)) {
+        CompiledLevel level;
+
+        if (level.open(get_compiled_level_path(entry.file_path))) {
+            entry.name = level.get_name();
+            entry.brick_count = static_cast<std::uint32_t>(level.get_brick_count());
+            entry.valid = true;
+
+            return;
+        }
+    }
+
+    LevelDescription level;
+
+    if (!parse_level_json(entry.file_path, level)) {
+        entry.valid = false;
+        return;
+    }
+
+    entry.name = level.name;
+    entry.brick_count = static_cast<std::uint32_t>(level.bricks.size());
+    entry.valid = true;
+}
+
+LevelIndex::~LevelIndex() {
+    stop();
+}
+
+void LevelIndex::scan(const std::string& directory) {
+    stop();
+
+    {
+        std::lock_guard<std::mutex> lock {mutex};
+        new_entries.clear();
+    }
+
+    stop_requested = false;
+    scanning = true;
+
+    thread = std::thread(&LevelIndex::scan_directory, this, directory);
+}
+
+void LevelIndex::stop() {
+    if (thread.joinable()) {
+        stop_requested = true;
+        thread.join();
+    }
+
+    scanning = false;
+}
+
+void LevelIndex::take_new_entries(std::vector<LevelIndexEntry>& entries) {
+    std::lock_guard<std::mutex> lock {mutex};
+
+    entries.insert(entries.end(), std::make_move_iterator(new_entries.begin()), std::make_move_iterator(new_entries.end()));
+    new_entries.clear();
+}
+
+void LevelIndex::scan_directory(const std::string& directory) {
+    const std::filesystem::path index_path {std::filesystem::path(directory) / INDEX_FILE_NAME};
+
+    auto cached_entries {load_index(index_path)};
+
+    // Levels always come in the same order
+    std::vector<std::filesystem::path> files;
+
+    {
+        std::error_code ec;
+
+        for (const auto& entry : std::filesystem::directory_iterator(directory, ec)) {
+            if (entry.is_regular_file(ec) && entry.path().extension() == ".json") {
+                files.push_back(entry.path());
+            }
+        }
+    }
+
+    std::sort(files.begin(), files.end());
+
+    std::vector<std::pair<std::string, LevelIndexEntry>> entries;
+    entries.reserve(files.size());
+
+    std::size_t i {0};
+
+    for (; i < files.size() && !stop_requested; i++) {
+        const auto& file {files[i]};
+
+        std::error_code ec;
+
+        LevelIndexEntry entry;
+        entry.file_path = file.string();
+        entry.modified_time = static_cast<std::int64_t>(std::filesystem::last_write_time(file, ec).time_since_epoch().count());
+
+        // A successful call clears the error of the previous one
+        if (ec) {
+            continue;
+        }
+
+        entry.size = std::filesystem::file_size(file, ec);
+
+        if (ec) {
+            continue;
+        }
+
+        const std::string file_name {file.filename().string()};
+        const auto iter {cached_entries.find(file_name)};
+
+        if (iter != cached_entries.end() && iter->second.modified_time == entry.modified_time && iter->second.size == entry.size) {
+            entry.name = iter->second.name;
+            entry.brick_count = iter->second.brick_count;
+            entry.valid = iter->second.valid;
+        } else {
+            read_entry(entry);
+
+            // Tabs and new lines would break the index file
+            std::replace_if(entry.name.begin(), entry.name.end(), [](char c) { return c == '\t' || c == '\n' || c == '\r'; }, ' ');
+        }
+
+        if (entry.valid) {
+            publish(entry);
+        }
+
+        entries.push_back(std::make_pair(file_name, std::move(entry)));
+    }
+
+    // Keep what was known about the levels that weren't reached
+    for (; i < files.size(); i++) {
+        const std::string file_name {files[i].filename().string()};
+        const auto iter {cached_entries.find(file_name)};
+
+        if (iter != cached_entries.end()) {
+            entries.push_back(std::make_pair(file_name, std::move(iter->second)));
+        }
+    }
+
+    save_index(index_path, entries);
+
+    scanning = false;
+}
+
+void LevelIndex::publish(const LevelIndexEntry& entry) {
+    std::lock_guard<std::mutex> lock {mutex};
+    new_entries.push_back(entry);
+}
@@ -0,0 +1,51 @@
+#pragma once
+
+#include <string>
+#include <vector>
+#include <thread>
+#include <mutex>
+#include <atomic>
+#include <cstdint>
+
+struct LevelIndexEntry {
+    std::string file_path;
+    std::string name;
+    std::int64_t modified_time {0};
+    std::uintmax_t size {0};
+    std::uint32_t brick_count {0u};
+    bool valid {false};  // Invalid levels are remembered too, so that they are not parsed again
+};
+
+// Metadata of the levels in a directory, saved in a file in there. Only the levels that are new or changed since the
+// last scan are parsed. Scanning happens on a background thread and the levels are handed out as soon as they are known.
+class LevelIndex {
+public:
+    LevelIndex() = default;
+    ~LevelIndex();
+
+    LevelIndex(const LevelIndex&) = delete;
+    LevelIndex& operator=(const LevelIndex&) = delete;
+    LevelIndex(LevelIndex&&) = delete;
+    LevelIndex& operator=(LevelIndex&&) = delete;
+
+    // Start over, stopping the previous scan
+    void scan(const std::string& directory);
+    void stop();
+
+    // Append the valid levels found since the last call
+    void take_new_entries(std::vector<LevelIndexEntry>& entries);
+
+    bool is_scanning() const { return scanning; }
+
+    static constexpr const char* INDEX_FILE_NAME {".index"};
+private:
+    void scan_directory(const std::string& directory);
+    void publish(const LevelIndexEntry& entry);
+
+    std::thread thread;
+    std::atomic<bool> stop_requested {false};
+    std::atomic<bool> scanning {false};
+
+    std::mutex mutex;
+    std::vector<LevelIndexEntry> new_entries;
+};
@@ -0,0 +1,45 @@
+#include "level_prefetch.hpp"
+
+#include <utility>
+
+LevelPrefetch::~LevelPrefetch() {
+    wait();
+}
+
+void LevelPrefetch::prefetch(const std::string& file_path) {
+    // Restarting a level would prefetch the same one again
+    if (this->file_path == file_path) {
+        return;
+    }
+
+    wait();
+
+    this->file_path = file_path;
+    loaded = false;
+
+    thread = std::thread([this]() {
+        loaded = read_level(this->file_path, level);
+    });
+}
+
+bool LevelPrefetch::take(const std::string& file_path, LevelDescription& level) {
+    wait();
+
+    if (this->file_path != file_path || !loaded) {
+        return false;
+    }
+
+    level = std::move(this->level);
+
+    this->file_path.clear();
+    this->level = LevelDescription();
+    loaded = false;
+
+    return true;
+}
+
+void LevelPrefetch::wait() {
+    if (thread.joinable()) {
+        thread.join();
+    }
+}
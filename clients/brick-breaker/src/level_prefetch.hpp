@@ -0,0 +1,33 @@
+#pragma once
+
+#include <string>
+#include <thread>
+
+#include "level_file.hpp"
+
+// Reads a level on a background thread, so that it's ready by the time it's played
+class LevelPrefetch {
+public:
+    LevelPrefetch() = default;
+    ~LevelPrefetch();
+
+    LevelPrefetch(const LevelPrefetch&) = delete;
+    LevelPrefetch& operator=(const LevelPrefetch&) = delete;
+    LevelPrefetch(LevelPrefetch&&) = delete;
+    LevelPrefetch& operator=(LevelPrefetch&&) = delete;
+
+    // Start reading a level, discarding the previous one
+    void prefetch(const std::string& file_path);
+
+    // Get the level, waiting for it if it's still being read; return false if it's not the one prefetched or it's invalid
+    bool take(const std::string& file_path, LevelDescription& level);
+private:
+    void wait();
+
+    std::thread thread;
+
+    // Written by the thread, read only after it's joined
+    std::string file_path;
+    LevelDescription level;
+    bool loaded {false};
+};
@@ -1,17 +1,15 @@
 #include "levels.hpp"
 
-#include <memory>
-#include <filesystem>
-#include <fstream>
+#include <string>
+#include <algorithm>
+#include <cstddef>
 
-#include <nlohmann/json.hpp>
 #include <glm/glm.hpp>
 
 #include "data.hpp"
 
 void LevelsScene::on_enter() {
-    const auto levels {reload_levels()};
-    level_selection = MenuSelection(static_cast<int>(levels));
+    reload_levels();
 
     cam_2d.set_projection_matrix(0.0f, static_cast<float>(get_width()), 0.0f, static_cast<float>(get_height()));
 
@@ -20,7 +18,7 @@ void LevelsScene::on_enter() {
 }
 
 void LevelsScene::on_exit() {
-
+    level_index.stop();
 }
 
 void LevelsScene::on_update() {
@@ -28,12 +26,20 @@ void LevelsScene::on_update() {
 
     capture(cam_2d);
 
+    level_index.take_new_entries(levels);
+    level_selection.resize(static_cast<int>(levels.size()));
+
     {
         int y_position {get_height() - 120};
 
-        for (std::size_t i {0}; i < level_paths.size(); i++) {
-            const auto& name {level_paths[i].second};
-            const bool selected {i == static_cast<std::size_t>(level_selection.get())};
+        // Show only the levels around the selected one
+        const std::size_t selection {static_cast<std::size_t>(level_selection.get())};
+        const std::size_t first {selection < static_cast<std::size_t>(MAX_LEVELS) ? 0 : selection - static_cast<std::size_t>(MAX_LEVELS) + 1};
+        const std::size_t last {std::min(first + static_cast<std::size_t>(MAX_LEVELS), levels.size())};
+
+        for (std::size_t i {first}; i < last; i++) {
+            const auto& name {levels[i].name};
+            const bool selected {i == selection};
 
             static constexpr float scale {1.2f};
             const auto string {selected ? "* " + name : name};
@@ -51,6 +57,22 @@ void LevelsScene::on_update() {
 
             y_position -= height + 6.0f;
         }
+
+        if (level_index.is_scanning()) {
+            static constexpr float scale {0.8f};
+            const std::string string {"Loading levels... " + std::to_string(levels.size())};
+
+            const auto [width, height] {data.basic_font->get_string_size(string, scale)};
+
+            bb::Text text;
+            text.font = data.basic_font;
+            text.string = string;
+            text.position = glm::vec2(static_cast<float>(get_width() - width) / 2.0f, y_position - 20);
+            text.color = glm::vec3(0.6f);
+            text.scale = scale;
+            text.shadows = true;
+            add_text(text);
+        }
     }
 }
 
@@ -71,14 +93,16 @@ void LevelsScene::on_key_released(const bb::KeyReleasedEvent& event) {
             play_sound(data.sound_switch);
             break;
         case bb::KeyCode::K_RETURN:
-            data.selected_level = level_paths.at(static_cast<std::size_t>(level_selection.get())).first;
+            if (levels.empty()) {
+                break;
+            }
+
+            data.selected_level = levels.at(static_cast<std::size_t>(level_selection.get())).file_path;
             change_scene("level");
             break;
-        case bb::KeyCode::K_l: {
-            const auto levels {reload_levels()};
-            level_selection = MenuSelection(static_cast<int>(levels));
+        case bb::KeyCode::K_l:
+            reload_levels();
             break;
-        }
         case bb::KeyCode::K_ESCAPE:
             change_scene("menu");
             break;
@@ -87,58 +111,10 @@ void LevelsScene::on_key_released(const bb::KeyReleasedEvent& event) {
     }
 }
 
-std::size_t LevelsScene::reload_levels() {
-    level_paths.clear();
-
-    const char* levels_directory {"data/levels/custom"};
-
-    const std::filesystem::path levels_path {levels_directory};
-
-    for (const auto& entry : std::filesystem::directory_iterator(levels_path)) {
-        if (!entry.is_regular_file()) {
-            continue;
-        }
-
-        const auto file {entry.path()};
-
-        if (file.extension().string() != ".json") {
-            continue;
-        }
-
-        const auto name {get_level_name(file.string())};
-
-        if (!name) {
-            continue;
-        }
-
-        level_paths.push_back(std::make_pair(file.string(), *name));
-
-        if (level_paths.size() == static_cast<std::size_t>(MAX_LEVELS)) {
-            break;
-        }
-    }
-
-    return level_paths.size();
-}
-
-std::optional<std::string> LevelsScene::get_level_name(const std::string& file_path) {
-    std::ifstream file {file_path};
-
-    if (!file.is_open()) {
-        return std::nullopt;
-    }
-
-    std::string result;
-
-    const nlohmann::json root = nlohmann::json::parse(file);
-
-    try {
-        const auto name {root["name"].get<std::string>()};
-
-        result = std::move(name);
-    } catch (const nlohmann::json::exception&) {
-        return std::nullopt;
-    }
+void LevelsScene::reload_levels() {
+    levels.clear();
+    level_selection = MenuSelection<int>(0);
 
-    return std::make_optional(result);
+    // Only new or changed levels are parsed, in the background
+    level_index.scan("data/levels/custom");
 }
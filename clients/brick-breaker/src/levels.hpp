@@ -1,12 +1,10 @@
 #include <vector>
-#include <string>
-#include <utility>
-#include <optional>
 #include <cstddef>
 
 #include <engine/engine.hpp>
 
 #include "menu_selection.hpp"
+#include "level_index.hpp"
 
 struct LevelsScene : public bb::Scene {
     LevelsScene()
@@ -19,13 +17,13 @@ struct LevelsScene : public bb::Scene {
     void on_window_resized(const bb::WindowResizedEvent& event);
     void on_key_released(const bb::KeyReleasedEvent& event);
 
-    std::size_t reload_levels();
-
-    std::optional<std::string> get_level_name(const std::string& file_path);
+    void reload_levels();
 
     bb::Camera2D cam_2d;
 
-    std::vector<std::pair<std::string, std::string>> level_paths;
+    // Filled in as the index finds the levels
+    LevelIndex level_index;
+    std::vector<LevelIndexEntry> levels;
     MenuSelection<int> level_selection;
 
     static constexpr int MAX_LEVELS {7};
@@ -1,3 +1,6 @@
+#include <cstring>
+#include <cstdlib>
+
 #include "engine/engine.hpp"
 
 #include "level.hpp"
@@ -6,7 +9,7 @@
 #include "about.hpp"
 #include "data.hpp"
 
-int main() {
+int main(int argc, char** argv) {
     Data data;
 
     bb::ApplicationProperties properties;
@@ -16,6 +19,26 @@ int main() {
     properties.samples = 4;
     properties.user_data = &data;
 
+    // Sessions can be recorded and replayed exactly, for reproducing bugs and for performance runs;
+    // replays can run headless too, stopping after a number of frames with a screenshot
+    for (int i {1}; i < argc; i++) {
+        if (std::strcmp(argv[i], "--headless") == 0) {
+            properties.headless = true;
+        } else if (i + 1 == argc) {
+            break;
+        } else if (std::strcmp(argv[i], "--record") == 0) {
+            properties.record_input_file = argv[++i];
+        } else if (std::strcmp(argv[i], "--replay") == 0) {
+            properties.replay_input_file = argv[++i];
+        } else if (std::strcmp(argv[i], "--log") == 0) {
+            properties.log_file = argv[++i];
+        } else if (std::strcmp(argv[i], "--frames") == 0) {
+            properties.frame_limit = std::atoi(argv[++i]);
+        } else if (std::strcmp(argv[i], "--screenshot") == 0) {
+            properties.screenshot_file = argv[++i];
+        }
+    }
+
     try {
         bb::Application application {properties};
         application.add_scene<MenuScene>();
@@ -24,7 +47,7 @@ int main() {
         application.add_scene<AboutScene>();
         application.run("menu");
     } catch (bb::RuntimeError error) {
-        bb::log_message("An error occurred: %d\n", error);
+        BB_LOG_ERROR(General, "An error occurred: %d\n", error);
         return 1;
     }
 
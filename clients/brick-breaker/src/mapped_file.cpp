@@ -0,0 +1,116 @@
+#include "mapped_file.hpp"
+
+#ifdef _WIN32
+    #define WIN32_LEAN_AND_MEAN
+    #include <windows.h>
+#else
+    #include <sys/mman.h>
+    #include <sys/stat.h>
+    #include <fcntl.h>
+    #include <unistd.h>
+#endif
+
+MappedFile::~MappedFile() {
+    close();
+}
+
+#ifdef _WIN32
+
+bool MappedFile::open(const std::string& file_path) {
+    close();
+
+    file = CreateFileA(file_path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+
+    if (file == INVALID_HANDLE_VALUE) {
+        file = nullptr;
+        return false;
+    }
+
+    LARGE_INTEGER file_size;
+
+    if (!GetFileSizeEx(file, &file_size) || file_size.QuadPart == 0) {
+        close();
+        return false;
+    }
+
+    mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+
+    if (mapping == nullptr) {
+        close();
+        return false;
+    }
+
+    data = static_cast<const unsigned char*>(MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0));
+
+    if (data == nullptr) {
+        close();
+        return false;
+    }
+
+    size = static_cast<std::size_t>(file_size.QuadPart);
+
+    return true;
+}
+
+void MappedFile::close() {
+    if (data != nullptr) {
+        UnmapViewOfFile(data);
+    }
+
+    if (mapping != nullptr) {
+        CloseHandle(mapping);
+    }
+
+    if (file != nullptr) {
+        CloseHandle(file);
+    }
+
+    data = nullptr;
+    size = 0;
+    mapping = nullptr;
+    file = nullptr;
+}
+
+#else
+
+bool MappedFile::open(const std::string& file_path) {
+    close();
+
+    const int descriptor {::open(file_path.c_str(), O_RDONLY)};
+
+    if (descriptor < 0) {
+        return false;
+    }
+
+    struct stat status;
+
+    if (fstat(descriptor, &status) < 0 || status.st_size == 0) {
+        ::close(descriptor);
+        return false;
+    }
+
+    void* address {mmap(nullptr, static_cast<std::size_t>(status.st_size), PROT_READ, MAP_PRIVATE, descriptor, 0)};
+
+    // The mapping stays valid after the file is closed
+    ::close(descriptor);
+
+    if (address == MAP_FAILED) {
+        return false;
+    }
+
+    data = static_cast<const unsigned char*>(address);
+    size = static_cast<std::size_t>(status.st_size);
+
+    return true;
+}
+
+void MappedFile::close() {
+    if (data != nullptr) {
+        munmap(const_cast<unsigned char*>(data), size);
+    }
+
+    data = nullptr;
+    size = 0;
+}
+
+#endif
@@ -0,0 +1,31 @@
+#pragma once
+
+#include <string>
+#include <cstddef>
+
+// Read only view of a whole file, mapped into memory
+class MappedFile {
+public:
+    MappedFile() = default;
+    ~MappedFile();
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+    MappedFile(MappedFile&&) = delete;
+    MappedFile& operator=(MappedFile&&) = delete;
+
+    // Return false if the file couldn't be mapped
+    bool open(const std::string& file_path);
+    void close();
+
+    const unsigned char* get_data() const { return data; }
+    std::size_t get_size() const { return size; }
+private:
+    const unsigned char* data {nullptr};
+    std::size_t size {0};
+
+#ifdef _WIN32
+    void* file {nullptr};
+    void* mapping {nullptr};
+#endif
+};
@@ -157,6 +157,9 @@ void MenuScene::load_font() {
     data.basic_font->bake_ascii();
     data.basic_font->bake_characters(u8"ă");
     data.basic_font->end_baking();
+
+    // F3 shows it
+    set_performance_overlay_font(data.basic_font);
 }
 
 void MenuScene::load_sounds() {
@@ -15,14 +15,32 @@ public:
     }
 
     void up() {
+        if (size == static_cast<T>(0)) {
+            return;
+        }
+
         selection = selection - static_cast<T>(1) < static_cast<T>(0) ? size - static_cast<T>(1) : selection - static_cast<T>(1);
     }
 
     void down() {
+        if (size == static_cast<T>(0)) {
+            return;
+        }
+
         selection = (selection + static_cast<T>(1)) % static_cast<int>(size);
     }
 
+    // For lists that grow or shrink, keeping the selection if possible
+    void resize(T size) {
+        this->size = size;
+
+        if (selection >= size) {
+            selection = size > static_cast<T>(0) ? size - static_cast<T>(1) : static_cast<T>(0);
+        }
+    }
+
     T get() const { return selection; }
+    T get_size() const { return size; }
 private:
     T selection {};
     T size {};
@@ -35,22 +35,12 @@ inline const int ORB_POINTS[static_cast<int>(OrbType::LAST) + 1] {
     15
 };
 
-class Orb {
-public:
-    Orb() = default;
-    Orb(unsigned int index, float x, float z, glm::vec3 velocity, OrbType type)
-        : position(glm::vec3(x, GROUND_LEVEL + radius + 0.2f, z)), velocity(velocity), index(index), type(type) {}
-
-    unsigned int get_index() const { return index; }
-    OrbType get_type() const { return type; }
-    int get_points() const { return ORB_POINTS[static_cast<int>(type)]; }
+inline constexpr float ORB_RADIUS {0.21f};
 
-    float radius {0.21f};
+struct Orb {
+    int get_points() const { return ORB_POINTS[static_cast<int>(type)]; }
 
-    glm::vec3 position {};
     glm::vec3 velocity {};
-private:
-    unsigned int index {};
 
     OrbType type {};
 };
@@ -10,13 +10,22 @@ public:
 
     glm::vec3 get_position() const { return glm::vec3(position_x, 0.7f, 10.5f); }
 
+    glm::vec3 get_interpolated_position(float alpha) const {
+        return glm::vec3(glm::mix(previous_position_x, position_x, alpha), 0.7f, 10.5f);
+    }
+
     void set_position(float position) {
         position_x = position;
     }
 
+    void save_position() {
+        previous_position_x = position_x;
+    }
+
     float velocity_x {0.0f};
 private:
     float position_x {0.0f};
+    float previous_position_x {0.0f};
 
     // TODO variable width
 };
@@ -0,0 +1,667 @@
+#include "simulation.hpp"
+
+#include <algorithm>
+#include <limits>
+
+#include <engine/profiler.hpp>
+#include <glm/gtx/quaternion.hpp>
+#include <glm/gtx/rotate_vector.hpp>
+
+#include "constants.hpp"
+
+static constexpr float mapf(float x, float in_min, float in_max, float out_min, float out_max) {
+    return (x - in_min) * (out_max - out_min) / (in_max - in_min) + out_min;
+}
+
+GameSimulation::GameSimulation(entt::registry& registry)
+    : registry(registry) {
+    dispatcher.sink<BallPaddleCollisionEvent>().connect<&GameSimulation::on_ball_paddle_collision>(*this);
+    dispatcher.sink<BallMissEvent>().connect<&GameSimulation::on_ball_miss>(*this);
+    dispatcher.sink<OrbMissEvent>().connect<&GameSimulation::on_orb_miss>(*this);
+    dispatcher.sink<OrbPaddleCollisionEvent>().connect<&GameSimulation::on_orb_paddle_collision>(*this);
+    dispatcher.sink<BallBrickCollisionEvent>().connect<&GameSimulation::on_ball_brick_collision>(*this);
+}
+
+bool GameSimulation::start(const std::string& file_path, int score, unsigned int lives, std::uint64_t seed) {
+    LevelDescription level;
+    const bool loaded {read_level(file_path, level)};
+
+    // Still start over with no bricks, if the level is invalid
+    if (!loaded) {
+        level = LevelDescription();
+    }
+
+    start(level, score, lives, seed);
+
+    return loaded;
+}
+
+void GameSimulation::start(const LevelDescription& level, int score, unsigned int lives, std::uint64_t seed) {
+    this->score = score;
+    this->lives = lives;
+    balls_lost = 0u;
+
+    random.seed(seed);
+
+    dispatcher.clear();
+    events.clear();
+
+    paddle = Paddle();
+
+    // All the entities belong to the game
+    registry.clear();
+    create_ball();
+
+    brick_grid.clear();
+    create_bricks(level, registry, random);
+
+    registry.view<Brick>().each([this](entt::entity entity, const Brick& brick) {
+        brick_grid.insert(entity, brick.grid);
+    });
+
+    // Levels may very well start with bricks in the air
+    unstable_columns.set();
+
+    death_flag = false;
+    game_over = GameOver::None;
+}
+
+void GameSimulation::update(const GameInput& input, float dt) {
+    BB_PROFILE_SCOPE("GameSimulation::update");
+
+    this->dt = dt;
+
+    events.clear();
+
+    if (input.shoot) {
+        shoot_balls();
+    }
+
+    if (input.left) {
+        paddle.velocity_x = -PADDLE_VELOCITY;
+    } else if (input.right) {
+        paddle.velocity_x = PADDLE_VELOCITY;
+    } else {
+        paddle.velocity_x = 0.0f;
+    }
+
+    if (death_flag) {
+        die();
+        death_flag = false;
+    }
+
+    update_bricks();
+
+    update_paddle(paddle, input.paddle_movement);
+
+    update_balls();
+
+    update_orbs();
+
+    update_collisions();
+
+    dispatcher.update();
+}
+
+void GameSimulation::update_collisions() {
+    BB_PROFILE_SCOPE("GameSimulation::update_collisions");
+
+    Box b;
+    b.position = paddle.get_position();
+    b.width = paddle.get_dimensions().x;
+    b.height = paddle.get_dimensions().y;
+    b.depth = paddle.get_dimensions().z;
+
+    // Balls collide while moving, so only the orbs are left
+    registry.view<Transform, SphereCollider, Orb>().each([&](entt::entity entity, const Transform& transform, const SphereCollider& collider, const Orb&) {
+        Sphere s;
+        s.position = transform.previous_position;
+        s.radius = collider.radius;
+
+        Contact contact;
+
+        if (sweep_sphere_box(s, transform.position - transform.previous_position, b, contact)) {
+            dispatcher.enqueue<OrbPaddleCollisionEvent>(entity);
+        }
+    });
+}
+
+void GameSimulation::update_bricks() {
+    BB_PROFILE_SCOPE("GameSimulation::update_bricks");
+
+    if (unstable_columns.none()) {
+        return;
+    }
+
+    for (std::size_t i {0}; i < unstable_columns.size(); i++) {
+        if (!unstable_columns.test(i)) {
+            continue;
+        }
+
+        const int x {static_cast<int>(i) % BrickGrid::SIZE_X + BRICKS_GRID_MIN_X};
+        const int z {static_cast<int>(i) / BrickGrid::SIZE_X + BRICKS_GRID_MIN_Z};
+
+        bool any_fell {false};
+
+        // Go from the bottom up, so that whole stacks fall at the same time
+        for (int y {BRICKS_GRID_MIN_Y + 1}; y <= BRICKS_GRID_MAX_Y; y++) {
+            const glm::ivec3 grid {x, y, z};
+
+            if (brick_grid.is_supported(grid)) {
+                continue;
+            }
+
+            // These bricks are in the air :P
+            while (brick_grid.is_occupied(grid)) {
+                const entt::entity entity {brick_grid.get_bricks(grid).back()};
+                auto [transform, brick] {registry.get<Transform, Brick>(entity)};
+
+                brick.grid.y--;
+                transform.position = Brick::grid_to_position(brick.grid);
+                transform.previous_position = transform.position;
+
+                brick_grid.move(entity, grid, brick.grid);
+
+                any_fell = true;
+            }
+        }
+
+        // Bricks fall one cell at a time, so check again the next time
+        if (!any_fell) {
+            unstable_columns.reset(i);
+        }
+    }
+}
+
+void GameSimulation::update_paddle(Paddle& paddle, float movement) {
+    paddle.save_position();
+    paddle.set_position(paddle.get_position().x + paddle.velocity_x * dt + movement);
+
+    static constexpr float min {PLATFORM_EDGE_MIN_X + 0.7f};
+    static constexpr float max {PLATFORM_EDGE_MAX_X - 0.7f};
+
+    if (paddle.get_position().x < min) {
+        paddle.set_position(min);
+    }
+
+    if (paddle.get_position().x > max) {
+        paddle.set_position(max);
+    }
+}
+
+void GameSimulation::update_orbs() {
+    BB_PROFILE_SCOPE("GameSimulation::update_orbs");
+
+    registry.view<Transform, Orb>().each([this](entt::entity entity, Transform& transform, const Orb& orb) {
+        transform.previous_position = transform.position;
+        transform.position += orb.velocity * dt;
+
+        if (transform.position.z > DEADLINE_Z) {
+            dispatcher.enqueue<OrbMissEvent>(entity);
+        }
+    });
+}
+
+void GameSimulation::update_balls() {
+    BB_PROFILE_SCOPE("GameSimulation::update_balls");
+
+    registry.view<Transform, SphereCollider, Ball>().each([this](entt::entity entity, Transform& transform, const SphereCollider& collider, Ball& ball) {
+        transform.previous_position = transform.position;
+
+        if (ball.attached_to_paddle) {
+            transform.position.x = paddle.get_position().x;
+            transform.position.z = paddle.get_position().z - 1.0f;
+        } else {
+            move_ball(entity, transform, collider, ball);
+        }
+
+        const auto perpendicular_velocity {glm::rotate(glm::normalize(ball.velocity), glm::radians(90.0f), glm::vec3(0.0f, 1.0f, 0.0f))};
+        const float current_rotation {rotate_ball(collider, ball)};
+
+        const glm::quat rot {glm::angleAxis(current_rotation, perpendicular_velocity)};
+        ball.rotation = rot * ball.rotation;
+
+        if (transform.position.x > PLATFORM_EDGE_MAX_X - collider.radius) {
+            transform.position.x = PLATFORM_EDGE_MAX_X - collider.radius;
+            ball.velocity.x *= -1.0f;
+
+            emit_sound(Sound::CollisionWall);
+        }
+
+        if (transform.position.x < PLATFORM_EDGE_MIN_X + collider.radius) {
+            transform.position.x = PLATFORM_EDGE_MIN_X + collider.radius;
+            ball.velocity.x *= -1.0f;
+
+            emit_sound(Sound::CollisionWall);
+        }
+
+        if (transform.position.z < PLATFORM_EDGE_MIN_Z + collider.radius) {
+            transform.position.z = PLATFORM_EDGE_MIN_Z + collider.radius;
+            ball.velocity.z *= -1.0f;
+
+            emit_sound(Sound::CollisionWall);
+        }
+
+        if (transform.position.z > DEADLINE_Z) {
+            dispatcher.enqueue<BallMissEvent>(entity);
+        }
+    });
+}
+
+void GameSimulation::move_ball(entt::entity entity, Transform& transform, const SphereCollider& collider, Ball& ball) {
+    hit_bricks.clear();
+
+    float remaining {1.0f};  // Fraction of the step left to move
+
+    for (int i {0}; i < BALL_MAX_SUBSTEPS && remaining > 0.0f; i++) {
+        const glm::vec3 displacement {ball.velocity * dt * remaining};
+
+        Sphere s;
+        s.position = transform.position;
+        s.radius = collider.radius;
+
+        Contact earliest;
+        earliest.time = std::numeric_limits<float>::max();
+
+        entt::entity hit_brick {entt::null};
+        bool hit_paddle {false};
+
+        {
+            Box b;
+            b.position = paddle.get_position();
+            b.width = paddle.get_dimensions().x;
+            b.height = paddle.get_dimensions().y;
+            b.depth = paddle.get_dimensions().z;
+
+            Contact contact;
+
+            if (sweep_sphere_box(s, displacement, b, contact)) {
+                earliest = contact;
+                hit_paddle = true;
+            }
+        }
+
+        // Test only the bricks in the cells around the path of the ball
+        Sphere path;
+        path.position = s.position + displacement * 0.5f;
+        path.radius = s.radius + glm::length(displacement) * 0.5f;
+
+        nearby_bricks.clear();
+        brick_grid.query(path, nearby_bricks);
+
+        nearby_boxes.clear();
+
+        for (const entt::entity brick : nearby_bricks) {
+            const auto [brick_transform, brick_collider] {registry.get<Transform, BoxCollider>(brick)};
+
+            Box b;
+            b.position = brick_transform.position;
+            b.width = brick_collider.extents.x;
+            b.height = brick_collider.extents.y;
+            b.depth = brick_collider.extents.z;
+
+            nearby_boxes.add(b);
+        }
+
+        // Only the boxes touching the path can be hit, and these are found in batches
+        collision_sphere_boxes(path, nearby_boxes, nearby_hits);
+
+        for (std::size_t j {0}; j < nearby_bricks.size(); j++) {
+            if (!(nearby_hits[j / 64] & (std::uint64_t {1} << (j % 64)))) {
+                continue;
+            }
+
+            const entt::entity brick {nearby_bricks[j]};
+
+            if (std::find(hit_bricks.cbegin(), hit_bricks.cend(), brick) != hit_bricks.cend()) {
+                continue;
+            }
+
+            const auto [brick_transform, brick_collider] {registry.get<Transform, BoxCollider>(brick)};
+
+            Box b;
+            b.position = brick_transform.position;
+            b.width = brick_collider.extents.x;
+            b.height = brick_collider.extents.y;
+            b.depth = brick_collider.extents.z;
+
+            Contact contact;
+
+            if (sweep_sphere_box(s, displacement, b, contact) && contact.time < earliest.time) {
+                earliest = contact;
+                hit_brick = brick;
+                hit_paddle = false;
+            }
+        }
+
+        if (!hit_paddle && hit_brick == entt::null) {
+            transform.position.x = s.position.x + displacement.x;
+            transform.position.z = s.position.z + displacement.z;
+
+            break;
+        }
+
+        // Stop right before the contact, so that the ball doesn't touch the box anymore
+        const glm::vec3 position {s.position + displacement * earliest.time + earliest.normal * CONTACT_SKIN};
+        transform.position.x = position.x;
+        transform.position.z = position.z;
+
+        remaining *= 1.0f - earliest.time;
+
+        const SphereBoxSide side {side_from_normal(earliest.normal)};
+
+        if (hit_paddle) {
+            if (side == SphereBoxSide::Back) {
+                const auto velocity {bounce_ball_off_paddle(transform.position, ball)};
+
+                ball.velocity.z = -velocity.y;
+                ball.velocity.x = velocity.x;
+            } else {
+                ball.velocity = glm::reflect(ball.velocity, earliest.normal);
+            }
+
+            dispatcher.enqueue<BallPaddleCollisionEvent>(entity, side);
+        } else {
+            if (!ball.fire) {
+                ball.velocity = glm::reflect(ball.velocity, earliest.normal);
+            }
+
+            hit_bricks.push_back(hit_brick);
+
+            dispatcher.enqueue<BallBrickCollisionEvent>(entity, hit_brick, side);
+        }
+    }
+}
+
+void GameSimulation::shoot_balls() {
+    bool any_ball {false};
+
+    registry.view<Ball>().each([this, &any_ball](Ball& ball) {
+        if (ball.attached_to_paddle) {
+            const auto vector {glm::vec3(random.linear(-5.0f, 5.0f), 0.0f, -5.0f)};
+            const auto direction {glm::normalize(vector)};
+
+            ball.velocity = direction * SHOOT_VELOCITY;
+            ball.attached_to_paddle = false;
+
+            any_ball = true;
+        }
+    });
+
+    if (any_ball) {
+        emit_sound(Sound::CollisionPaddle);
+    }
+}
+
+void GameSimulation::create_ball() {
+    const entt::entity entity {registry.create()};
+
+    Transform& transform {registry.emplace<Transform>(entity)};
+    transform.position = glm::vec3(paddle.get_position().x, GROUND_LEVEL + BALL_RADIUS_NORMAL, paddle.get_position().z - 1.0f);
+    transform.previous_position = transform.position;  // Don't interpolate from the origin
+
+    registry.emplace<SphereCollider>(entity, BALL_RADIUS_NORMAL);
+
+    // Last, so that everything is in place when it's constructed
+    registry.emplace<Ball>(entity);
+}
+
+void GameSimulation::spawn_orb(glm::vec3 position) {
+    const auto velocity {glm::vec3(0.0f, 0.0f, random.linear(5.0f, 7.0f))};
+    const float random_type {random.linear(static_cast<float>(OrbType::FIRST), static_cast<float>(OrbType::LAST) + 1.0f)};
+
+    const entt::entity entity {registry.create()};
+
+    Transform& transform {registry.emplace<Transform>(entity)};
+    transform.position = glm::vec3(position.x, GROUND_LEVEL + ORB_RADIUS + 0.2f, position.z);
+    transform.previous_position = transform.position;
+
+    registry.emplace<SphereCollider>(entity, ORB_RADIUS);
+
+    Orb orb;
+    orb.velocity = velocity;
+    orb.type = static_cast<OrbType>(static_cast<int>(random_type));
+
+    // Last and complete, so that the type is already known when it's constructed
+    registry.emplace<Orb>(entity, orb);
+}
+
+void GameSimulation::destroy_balls_and_orbs() {
+    const auto balls {registry.view<Ball>()};
+    registry.destroy(balls.begin(), balls.end());
+
+    const auto orbs {registry.view<Orb>()};
+    registry.destroy(orbs.begin(), orbs.end());
+}
+
+void GameSimulation::set_ball_radius(entt::entity entity, float radius) {
+    auto [transform, collider] {registry.get<Transform, SphereCollider>(entity)};
+
+    // Balls always sit on the ground
+    collider.radius = radius;
+    transform.position.y = GROUND_LEVEL + radius;
+    transform.previous_position.y = transform.position.y;
+}
+
+void GameSimulation::win() {
+    game_over = GameOver::Won;
+    destroy_balls_and_orbs();
+
+    emit_sound(Sound::Won);
+}
+
+void GameSimulation::lose() {
+    game_over = GameOver::Lost;
+    // Balls and orbs are already destroyed
+
+    emit_sound(Sound::Lost);
+}
+
+void GameSimulation::die() {
+    emit_sound(Sound::Die);
+
+    emit_lives(-1);
+    destroy_balls_and_orbs();
+
+    if (lives == 0) {
+        lose();
+    } else {
+        paddle = Paddle();
+        create_ball();
+    }
+}
+
+bool GameSimulation::load_level(const std::string& file_path, entt::registry& registry, bb::Random& random) {
+    LevelDescription level;
+
+    if (!read_level(file_path, level)) {
+        return false;
+    }
+
+    create_bricks(level, registry, random);
+
+    return true;
+}
+
+void GameSimulation::create_bricks(const LevelDescription& level, entt::registry& registry, bb::Random& random) {
+    for (const LevelFileBrick& brick : level.bricks) {
+        create_brick(registry, brick, random);
+    }
+}
+
+void GameSimulation::create_brick(entt::registry& registry, const LevelFileBrick& brick, bb::Random& random) {
+    const glm::ivec3 grid {brick.x, brick.y, brick.z};
+
+    const bool rot_y {random.chance(0.5f)};
+    const bool rot_z {random.chance(0.5f)};
+
+    const entt::entity entity {registry.create()};
+
+    Transform& transform {registry.emplace<Transform>(entity)};
+    transform.position = Brick::grid_to_position(grid);
+    transform.previous_position = transform.position;
+
+    registry.emplace<BoxCollider>(entity, Brick::get_dimensions());
+    registry.emplace<Brick>(entity, grid, rot_y, rot_z, static_cast<BrickType>(brick.type));
+}
+
+glm::vec2 GameSimulation::bounce_ball_off_paddle(glm::vec3 position, const Ball& ball) {
+    // https://www.mathsisfun.com/polar-cartesian-coordinates.html
+
+    const float original_velocity {glm::length(ball.velocity)};
+
+    const float distance {glm::abs(paddle.get_position().x - position.x)};
+    const float theta {mapf(distance, 0.0f, paddle.get_dimensions().x, 0.0f, 70.0f)};
+
+    const float directed_theta {paddle.get_position().x - position.x > 0.0f ? theta + 90.0f : -theta + 90.0f};
+
+    return glm::vec2(original_velocity * glm::cos(glm::radians(directed_theta)), original_velocity * glm::sin(glm::radians(directed_theta)));
+}
+
+float GameSimulation::rotate_ball(const SphereCollider& collider, const Ball& ball) {
+    const float velocity {glm::length(ball.velocity) * dt};
+    const float half_diameter {glm::pi<float>() * collider.radius};
+    const float theta {velocity / half_diameter};  // Radians
+
+    return theta;
+}
+
+void GameSimulation::on_ball_paddle_collision(const BallPaddleCollisionEvent&) {
+    // The ball has already bounced off
+    emit_sound(Sound::CollisionPaddle);
+}
+
+void GameSimulation::on_ball_miss(const BallMissEvent& event) {
+    // Entities may have been destroyed in the meantime
+    if (!registry.valid(event.ball)) {
+        return;
+    }
+
+    registry.destroy(event.ball);
+    balls_lost++;
+
+    if (registry.view<Ball>().empty()) {
+        death_flag = true;
+    }
+}
+
+void GameSimulation::on_orb_miss(const OrbMissEvent& event) {
+    if (registry.valid(event.orb)) {
+        registry.destroy(event.orb);
+    }
+}
+
+void GameSimulation::on_orb_paddle_collision(const OrbPaddleCollisionEvent& event) {
+    if (!registry.valid(event.orb)) {
+        return;
+    }
+
+    const Orb orb {registry.get<Orb>(event.orb)};
+    registry.destroy(event.orb);
+
+    emit_sound(Sound::Switch);
+
+    emit_score(orb.get_points());
+
+    switch (orb.type) {
+        case OrbType::SpeedUp:
+            registry.view<Ball>().each([](Ball& ball) {
+                ball.velocity *= 1.25f;
+            });
+
+            break;
+        case OrbType::SpeedDown:
+            registry.view<Ball>().each([](Ball& ball) {
+                ball.velocity *= 0.8f;
+            });
+
+            break;
+        case OrbType::ExtraLife:
+            emit_lives(1);
+
+            break;
+        case OrbType::Die:
+            death_flag = true;
+
+            break;
+        case OrbType::FireBall:
+            registry.view<Ball>().each([this](entt::entity entity, Ball& ball) {
+                ball.fire = true;
+                set_ball_radius(entity, BALL_RADIUS_FIRE);
+            });
+
+            break;
+        case OrbType::NormalBall:
+            registry.view<Ball>().each([this](entt::entity entity, Ball& ball) {
+                ball.fire = false;
+                set_ball_radius(entity, BALL_RADIUS_NORMAL);
+            });
+
+            break;
+        case OrbType::ExtraBall:
+            create_ball();
+
+            break;
+        default:
+            break;
+    }
+}
+
+void GameSimulation::on_ball_brick_collision(const BallBrickCollisionEvent& event) {
+    if (!registry.valid(event.ball)) {
+        return;
+    }
+
+    // The ball has already bounced off or gone through
+    if (!registry.valid(event.brick)) {
+        return;
+    }
+
+    const auto [transform, brick] {registry.get<Transform, Brick>(event.brick)};
+
+    emit_score(brick.get_points());
+
+    emit_sound(Sound::CollisionBrick);
+
+    if (random.linear(0.0f, 1.0f) > ORB_RATE) {
+        spawn_orb(transform.position);
+    }
+
+    // Anything above this brick may fall now
+    unstable_columns.set(BrickGrid::column_index(brick.grid));
+
+    brick_grid.remove(event.brick, brick.grid);
+    registry.destroy(event.brick);
+
+    if (registry.view<Brick>().empty()) {
+        win();
+    }
+}
+
+void GameSimulation::emit_sound(Sound sound) {
+    GameEvent event;
+    event.type = GameEvent::Type::Sound;
+    event.sound = sound;
+
+    events.push_back(event);
+}
+
+void GameSimulation::emit_score(int points) {
+    score += points;
+
+    GameEvent event;
+    event.type = GameEvent::Type::Score;
+    event.points = points;
+
+    events.push_back(event);
+}
+
+void GameSimulation::emit_lives(int lives) {
+    this->lives += lives;
+
+    GameEvent event;
+    event.type = GameEvent::Type::Lives;
+    event.lives = lives;
+
+    events.push_back(event);
+}
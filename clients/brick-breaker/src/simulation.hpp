@@ -0,0 +1,157 @@
+#pragma once
+
+#include <string>
+#include <vector>
+#include <bitset>
+#include <cstdint>
+
+#include <engine/random.hpp>
+#include <entt/entity/registry.hpp>
+#include <entt/signal/dispatcher.hpp>
+#include <glm/glm.hpp>
+
+#include "collision.hpp"
+#include "brick_grid.hpp"
+#include "paddle.hpp"
+#include "ball.hpp"
+#include "brick.hpp"
+#include "orb.hpp"
+#include "components.hpp"
+#include "level_file.hpp"
+#include "events.hpp"
+
+enum class Sound {
+    CollisionBrick,
+    CollisionPaddle,
+    CollisionWall,
+    Die,
+    Lost,
+    Won,
+    Switch
+};
+
+// Things that happened in the game, for the outside to react to
+struct GameEvent {
+    enum class Type {
+        Sound,
+        Score,
+        Lives
+    } type {};
+
+    Sound sound {};  // For Type::Sound
+    int points {};  // For Type::Score
+    int lives {};  // For Type::Lives, gained or lost
+};
+
+struct GameInput {
+    bool left {false};
+    bool right {false};
+    bool shoot {false};
+    float paddle_movement {0.0f};  // Instant movement, for the mouse
+};
+
+enum class GameOver {
+    None,
+    Lost,
+    Won
+};
+
+// All the game logic, independent of the engine, so that it can run without a window, a context or audio.
+// Balls, bricks and orbs are entities in the registry, which is owned by the simulation while it runs.
+class GameSimulation {
+public:
+    GameSimulation(entt::registry& registry);
+    ~GameSimulation() = default;
+
+    GameSimulation(const GameSimulation&) = delete;
+    GameSimulation& operator=(const GameSimulation&) = delete;
+    GameSimulation(GameSimulation&&) = delete;
+    GameSimulation& operator=(GameSimulation&&) = delete;
+
+    // Start over with a level, returning false if it couldn't be loaded; the same seed gives the same game
+    bool start(const std::string& file_path, int score, unsigned int lives, std::uint64_t seed);
+
+    // Start over with a level that has already been read
+    void start(const LevelDescription& level, int score, unsigned int lives, std::uint64_t seed);
+
+    // Advance the game by dt seconds
+    void update(const GameInput& input, float dt);
+
+    const Paddle& get_paddle() const { return paddle; }
+    GameOver get_game_over() const { return game_over; }
+    int get_score() const { return score; }
+    unsigned int get_lives() const { return lives; }
+    unsigned int get_balls_lost() const { return balls_lost; }
+
+    // Emitted during the last update
+    const std::vector<GameEvent>& get_events() const { return events; }
+
+    // Create the bricks of a level, returning false if the file is invalid
+    static bool load_level(const std::string& file_path, entt::registry& registry, bb::Random& random);
+
+    // Create the bricks of a level that has already been read
+    static void create_bricks(const LevelDescription& level, entt::registry& registry, bb::Random& random);
+private:
+    static void create_brick(entt::registry& registry, const LevelFileBrick& brick, bb::Random& random);
+
+    void update_collisions();
+    void update_bricks();
+    void update_paddle(Paddle& paddle, float movement);
+    void update_orbs();
+    void update_balls();
+    void move_ball(entt::entity entity, Transform& transform, const SphereCollider& collider, Ball& ball);
+    void shoot_balls();
+    void create_ball();
+    void spawn_orb(glm::vec3 position);
+    void destroy_balls_and_orbs();
+    void set_ball_radius(entt::entity entity, float radius);
+    void win();
+    void lose();
+    void die();  // Should be called only once per update
+    glm::vec2 bounce_ball_off_paddle(glm::vec3 position, const Ball& ball);
+    float rotate_ball(const SphereCollider& collider, const Ball& ball);
+    void on_ball_paddle_collision(const BallPaddleCollisionEvent& event);
+    void on_ball_miss(const BallMissEvent& event);
+    void on_orb_miss(const OrbMissEvent& event);
+    void on_orb_paddle_collision(const OrbPaddleCollisionEvent& event);
+    void on_ball_brick_collision(const BallBrickCollisionEvent& event);
+
+    void emit_sound(Sound sound);
+    void emit_score(int points);
+    void emit_lives(int lives);
+
+    entt::registry& registry;
+
+    Paddle paddle;
+
+    // Broadphase for ball-brick collisions and occupancy for gravity
+    BrickGrid brick_grid;
+    std::vector<entt::entity> nearby_bricks;
+    BoxArray nearby_boxes;
+    std::vector<std::uint64_t> nearby_hits;
+
+    // Bricks already hit by the ball being moved, as fire balls go through them
+    std::vector<entt::entity> hit_bricks;
+
+    // Columns (x, z) in which bricks might be in the air
+    std::bitset<BrickGrid::SIZE_X * BrickGrid::SIZE_Z> unstable_columns;
+
+    bool death_flag {false};
+    GameOver game_over {};
+
+    bb::Random random;
+
+    int score {0};
+    unsigned int lives {0u};
+    unsigned int balls_lost {0u};  // Since the start, for statistics
+
+    float dt {0.0f};  // Of the current update
+
+    // Collisions are resolved after everything has moved
+    entt::dispatcher dispatcher;
+
+    std::vector<GameEvent> events;
+
+    // Times the steps of an update on their own
+    friend struct GameSimulationBench;
+};
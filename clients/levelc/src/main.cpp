@@ -0,0 +1,74 @@
+#include <string>
+#include <vector>
+#include <filesystem>
+#include <system_error>
+#include <cstdio>
+
+#include "level_file.hpp"
+
+// Return false if the level is invalid
+static bool compile(const std::filesystem::path& file_path) {
+    const std::string path {file_path.string()};
+
+    LevelDescription level;
+    std::string error;
+
+    if (!parse_level_json(path, level, &error)) {
+        std::printf("%s: error: %s\n", path.c_str(), error.c_str());
+        return false;
+    }
+
+    if (level.name.size() >= sizeof(LevelFileHeader::name)) {
+        std::printf("%s: warning: name is longer than %zu characters and is truncated\n", path.c_str(), sizeof(LevelFileHeader::name) - 1);
+    }
+
+    const std::string compiled_path {get_compiled_level_path(path)};
+
+    if (!write_compiled_level(compiled_path, level)) {
+        std::printf("%s: error: could not write `%s`\n", path.c_str(), compiled_path.c_str());
+        return false;
+    }
+
+    std::printf("%s: %zu bricks -> %s\n", path.c_str(), level.bricks.size(), compiled_path.c_str());
+
+    return true;
+}
+
+int main(int argc, char** argv) {
+    if (argc < 2) {
+        std::printf("Usage: bb-levelc <level.json or directory>...\n");
+        return 1;
+    }
+
+    std::vector<std::filesystem::path> files;
+
+    for (int i {1}; i < argc; i++) {
+        const std::filesystem::path path {argv[i]};
+        std::error_code ec;
+
+        if (std::filesystem::is_directory(path, ec)) {
+            for (const auto& entry : std::filesystem::recursive_directory_iterator(path, ec)) {
+                if (entry.is_regular_file() && entry.path().extension() == ".json") {
+                    files.push_back(entry.path());
+                }
+            }
+        } else {
+            files.push_back(path);
+        }
+    }
+
+    std::size_t failed {0};
+
+    for (const auto& file : files) {
+        if (!compile(file)) {
+            failed++;
+        }
+    }
+
+    if (failed > 0) {
+        std::printf("%zu of %zu levels are invalid\n", failed, files.size());
+        return 1;
+    }
+
+    return 0;
+}
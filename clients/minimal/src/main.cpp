@@ -25,7 +25,7 @@ int main() {
         application.add_scene<MyScene>();
         application.run("my_scene");
     } catch (bb::RuntimeError error) {
-        bb::log_message("An error occurred: %d\n", error);
+        BB_LOG_ERROR(General, "An error occurred: %d\n", error);
         return 1;
     }
 
@@ -0,0 +1,232 @@
+#include <string>
+#include <memory>
+#include <vector>
+#include <algorithm>
+#include <numeric>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <cstdio>
+
+#include <engine/render_capture.hpp>
+#include <engine/window.hpp>
+#include <engine/renderer.hpp>
+#include <engine/gpu_timer.hpp>
+#include <engine/panic.hpp>
+#include <glad/glad.h>
+
+struct Options {
+    std::string capture;
+    int frames {500};
+    int warm_up_frames {50};
+    std::string screenshot;  // Of the last frame, if not empty
+};
+
+struct PassTotal {
+    std::string name;
+    double gpu {0.0};  // Milliseconds, over all the frames
+    double cpu {0.0};
+    std::size_t frames {0};
+};
+
+static double nanoseconds_to_milliseconds(std::uint64_t nanoseconds) {
+    return static_cast<double>(nanoseconds) / 1'000'000.0;
+}
+
+static double percentile(const std::vector<double>& sorted, double p) {
+    const std::size_t index {static_cast<std::size_t>(p * static_cast<double>(sorted.size() - 1) + 0.5)};
+    return sorted[index];
+}
+
+static void print_times(const char* name, std::vector<double> times) {
+    if (times.empty()) {
+        std::printf("%-8s not available\n", name);
+        return;
+    }
+
+    std::sort(times.begin(), times.end());
+
+    const double mean {std::accumulate(times.cbegin(), times.cend(), 0.0) / static_cast<double>(times.size())};
+
+    std::printf(
+        "%-8s mean %.3f ms, min %.3f, p50 %.3f, p95 %.3f, p99 %.3f, max %.3f\n",
+        name,
+        mean,
+        times.front(),
+        percentile(times, 0.5),
+        percentile(times, 0.95),
+        percentile(times, 0.99),
+        times.back()
+    );
+}
+
+static void add_pass_times(const std::vector<bb::GpuPassTime>& pass_times, std::vector<PassTotal>& totals, std::vector<double>& gpu_times) {
+    if (pass_times.empty()) {
+        return;
+    }
+
+    double gpu_time {0.0};
+
+    for (const bb::GpuPassTime& pass_time : pass_times) {
+        auto iter {std::find_if(totals.begin(), totals.end(), [&](const PassTotal& total) {
+            return total.name == pass_time.name;
+        })};
+
+        if (iter == totals.end()) {
+            PassTotal total;
+            total.name = pass_time.name;
+
+            iter = totals.insert(totals.end(), total);
+        }
+
+        const double duration {nanoseconds_to_milliseconds(pass_time.end - pass_time.begin)};
+
+        iter->gpu += duration;
+        iter->cpu += nanoseconds_to_milliseconds(pass_time.cpu_duration);
+        iter->frames++;
+
+        gpu_time += duration;
+    }
+
+    gpu_times.push_back(gpu_time);
+}
+
+static void print_usage() {
+    std::printf("Usage: bb-render-replay <capture.bbrc> [--frames N] [--warm-up N] [--screenshot FILE]\n");
+}
+
+static bool parse_options(int argc, char** argv, Options& options) {
+    if (argc < 2) {
+        return false;
+    }
+
+    options.capture = argv[1];
+
+    for (int i {2}; i < argc; i += 2) {
+        if (i + 1 == argc) {
+            return false;
+        }
+
+        const char* name {argv[i]};
+        const char* value {argv[i + 1]};
+
+        if (std::strcmp(name, "--frames") == 0) {
+            options.frames = std::atoi(value);
+        } else if (std::strcmp(name, "--warm-up") == 0) {
+            options.warm_up_frames = std::atoi(value);
+        } else if (std::strcmp(name, "--screenshot") == 0) {
+            options.screenshot = value;
+        } else {
+            return false;
+        }
+    }
+
+    return options.frames > 0 && options.warm_up_frames >= 0;
+}
+
+int main(int argc, char** argv) {
+    using namespace std::chrono;
+
+    Options options;
+
+    if (!parse_options(argc, argv, options)) {
+        print_usage();
+        return 1;
+    }
+
+    bb::RenderCapture capture;
+
+    try {
+        capture.load(options.capture);
+    } catch (bb::RuntimeError) {
+        std::printf("Could not load capture `%s`\n", options.capture.c_str());
+        return 1;
+    }
+
+    // Rendered offscreen at the size of the capture, without a display
+    bb::WindowProperties properties;
+    properties.width = capture.get_width();
+    properties.height = capture.get_height();
+    properties.headless = true;
+
+    std::unique_ptr<bb::Window> window;
+
+    try {
+        window = std::make_unique<bb::Window>(properties, nullptr);
+    } catch (bb::RuntimeError) {
+        std::printf("Could not create an OpenGL context\n");
+        return 1;
+    }
+
+    bb::Renderer renderer {capture.get_width(), capture.get_height(), capture.get_samples()};
+
+    try {
+        capture.create_resources(renderer);
+    } catch (bb::RuntimeError) {
+        std::printf("Could not create the resources of capture `%s`\n", options.capture.c_str());
+        return 1;
+    }
+
+    renderer.set_gpu_timing(true);
+
+    // Let the driver compile everything and the timer queries fill up
+    for (int i {0}; i < options.warm_up_frames; i++) {
+        capture.replay(renderer);
+        glFinish();
+    }
+
+    std::vector<double> cpu_times;  // Of submitting the frame
+    std::vector<double> frame_times;  // Until the GPU is done too
+    std::vector<double> gpu_times;  // Of all the passes
+    std::vector<PassTotal> pass_totals;
+
+    for (int i {0}; i < options.frames; i++) {
+        const auto begin {steady_clock::now()};
+
+        capture.replay(renderer);
+
+        const auto submitted {steady_clock::now()};
+
+        // One frame at a time, so that the frames don't overlap
+        glFinish();
+
+        const auto end {steady_clock::now()};
+
+        cpu_times.push_back(duration<double, std::milli>(submitted - begin).count());
+        frame_times.push_back(duration<double, std::milli>(end - begin).count());
+
+        add_pass_times(renderer.get_gpu_pass_times(), pass_totals, gpu_times);
+    }
+
+    if (!options.screenshot.empty() && !window->save_frame(options.screenshot)) {
+        std::printf("Could not save screenshot `%s`\n", options.screenshot.c_str());
+        return 1;
+    }
+
+    std::printf("capture  %s\n", options.capture.c_str());
+    std::printf(
+        "size     %dx%d, %d samples, %zu renderables\n",
+        capture.get_width(),
+        capture.get_height(),
+        capture.get_samples(),
+        capture.get_renderable_count()
+    );
+    std::printf("frames   %d, after %d to warm up\n", options.frames, options.warm_up_frames);
+    std::printf("renderer %s\n", reinterpret_cast<const char*>(glGetString(GL_RENDERER)));
+
+    print_times("cpu", cpu_times);
+    print_times("frame", frame_times);
+    print_times("gpu", gpu_times);
+
+    for (const PassTotal& total : pass_totals) {
+        std::printf(
+            "  %-16s gpu %.3f ms, cpu %.3f ms on average\n",
+            total.name.c_str(),
+            total.gpu / static_cast<double>(total.frames),
+            total.cpu / static_cast<double>(total.frames)
+        );
+    }
+
+    return 0;
+}
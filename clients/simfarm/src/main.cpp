@@ -0,0 +1,280 @@
+#include <string>
+#include <vector>
+#include <algorithm>
+#include <numeric>
+#include <chrono>
+#include <thread>
+#include <cstdint>
+#include <climits>
+#include <cerrno>
+#include <cstdlib>
+#include <cstring>
+#include <cstdio>
+
+#include <entt/entity/registry.hpp>
+#include <glm/glm.hpp>
+
+#include "simulation.hpp"
+#include "level_file.hpp"
+#include "thread_pool.hpp"
+
+static constexpr float FIXED_DT {1.0f / 120.0f};  // Same as the game
+static constexpr unsigned int LIVES {3u};
+
+enum class PaddleControl {
+    Follow,  // Bot that follows the ball nearest to the deadline
+    Sweep  // Scripted, goes from one side to the other
+};
+
+struct Options {
+    std::string level;
+    std::size_t games {1000};
+    unsigned int threads {std::max(std::thread::hardware_concurrency(), 1u)};
+    std::uint64_t seed {1u};
+    PaddleControl paddle_control {PaddleControl::Follow};
+    float max_time {600.0f};  // Simulated seconds after which a game is abandoned
+};
+
+struct GameResult {
+    GameOver game_over {};
+    float time {0.0f};  // Simulated seconds
+    int score {0};
+    unsigned int balls_lost {0u};
+};
+
+static void control_paddle(const entt::registry& registry, const GameSimulation& simulation, PaddleControl paddle_control, float time, GameInput& input) {
+    const float paddle_x {simulation.get_paddle().get_position().x};
+
+    input.shoot = true;
+    input.left = false;
+    input.right = false;
+
+    switch (paddle_control) {
+        case PaddleControl::Follow: {
+            bool any_ball {false};
+            glm::vec3 target {};
+
+            registry.view<Transform, Ball>().each([&](const Transform& transform, const Ball&) {
+                if (!any_ball || transform.position.z > target.z) {
+                    target = transform.position;
+                    any_ball = true;
+                }
+            });
+
+            if (any_ball) {
+                input.left = target.x < paddle_x - 0.5f;
+                input.right = target.x > paddle_x + 0.5f;
+            }
+
+            break;
+        }
+        case PaddleControl::Sweep: {
+            // Change direction every couple of seconds
+            const bool go_left {static_cast<int>(time / 2.0f) % 2 == 0};
+
+            input.left = go_left;
+            input.right = !go_left;
+
+            break;
+        }
+    }
+}
+
+// Every game has its own registry, simulation and generator; only the level, which is read only, is shared
+static GameResult play_game(const Options& options, const LevelDescription& level, std::uint64_t seed) {
+    entt::registry registry;
+    GameSimulation simulation {registry};
+
+    GameResult result;
+
+    simulation.start(level, 0, LIVES, seed);
+
+    GameInput input;
+
+    while (simulation.get_game_over() == GameOver::None && result.time < options.max_time) {
+        control_paddle(registry, simulation, options.paddle_control, result.time, input);
+        simulation.update(input, FIXED_DT);
+
+        result.time += FIXED_DT;
+    }
+
+    result.game_over = simulation.get_game_over();
+    result.score = simulation.get_score();
+    result.balls_lost = simulation.get_balls_lost();
+
+    return result;
+}
+
+static int percentile(const std::vector<int>& sorted, double p) {
+    const std::size_t index {static_cast<std::size_t>(p * static_cast<double>(sorted.size() - 1) + 0.5)};
+    return sorted[index];
+}
+
+static void print_report(const Options& options, const std::vector<GameResult>& results, double wall_time) {
+    std::size_t won {0};
+    std::size_t lost {0};
+    double time_to_clear {0.0};
+    unsigned long long balls_lost {0};
+
+    std::vector<int> scores;
+    scores.reserve(results.size());
+
+    for (const GameResult& result : results) {
+        switch (result.game_over) {
+            case GameOver::Won:
+                won++;
+                time_to_clear += static_cast<double>(result.time);
+                break;
+            case GameOver::Lost:
+                lost++;
+                break;
+            case GameOver::None:
+                break;
+        }
+
+        balls_lost += result.balls_lost;
+        scores.push_back(result.score);
+    }
+
+    std::sort(scores.begin(), scores.end());
+
+    const double games {static_cast<double>(results.size())};
+    const double mean_score {static_cast<double>(std::accumulate(scores.cbegin(), scores.cend(), 0ll)) / games};
+
+    std::printf("level          %s\n", options.level.c_str());
+    std::printf("games          %zu on %u threads in %.2f s (%.1f games/s)\n", results.size(), options.threads, wall_time, games / wall_time);
+    std::printf("won            %zu (%.1f%%)\n", won, 100.0 * static_cast<double>(won) / games);
+    std::printf("lost           %zu (%.1f%%)\n", lost, 100.0 * static_cast<double>(lost) / games);
+    std::printf("unfinished     %zu\n", results.size() - won - lost);
+    std::printf("time to clear  %.1f s on average\n", won > 0 ? time_to_clear / static_cast<double>(won) : 0.0);
+    std::printf("balls lost     %.2f on average\n", static_cast<double>(balls_lost) / games);
+    std::printf("score          mean %.1f\n", mean_score);
+    std::printf("               min %d, p10 %d, p25 %d, p50 %d, p75 %d, p90 %d, max %d\n",
+        scores.front(),
+        percentile(scores, 0.1),
+        percentile(scores, 0.25),
+        percentile(scores, 0.5),
+        percentile(scores, 0.75),
+        percentile(scores, 0.9),
+        scores.back()
+    );
+}
+
+static void print_usage() {
+    std::printf(
+        "Usage: bb-simfarm <level.json> [--games N] [--threads N] [--seed N] [--paddle follow|sweep] [--max-time SECONDS]\n"
+    );
+}
+
+// The whole value must be a number, not just the start of it
+static bool parse_unsigned(const char* value, unsigned long long max, unsigned long long& result) {
+    if (*value < '0' || *value > '9') {
+        return false;  // Also a sign, which strtoull would accept
+    }
+
+    char* end {nullptr};
+    errno = 0;
+    result = std::strtoull(value, &end, 10);
+
+    return *end == '\0' && errno == 0 && result <= max;
+}
+
+static bool parse_float(const char* value, float& result) {
+    char* end {nullptr};
+    errno = 0;
+    result = std::strtof(value, &end);
+
+    return end != value && *end == '\0' && errno == 0;
+}
+
+static bool parse_options(int argc, char** argv, Options& options) {
+    // The level and then the options, each with its value
+    if (argc < 2 || argc % 2 != 0) {
+        return false;
+    }
+
+    options.level = argv[1];
+
+    for (int i {2}; i + 1 < argc; i += 2) {
+        const char* name {argv[i]};
+        const char* value {argv[i + 1]};
+
+        unsigned long long number {0};
+
+        if (std::strcmp(name, "--games") == 0) {
+            if (!parse_unsigned(value, SIZE_MAX, number)) {
+                return false;
+            }
+
+            options.games = static_cast<std::size_t>(number);
+        } else if (std::strcmp(name, "--threads") == 0) {
+            if (!parse_unsigned(value, UINT_MAX, number)) {
+                return false;
+            }
+
+            options.threads = static_cast<unsigned int>(number);
+        } else if (std::strcmp(name, "--seed") == 0) {
+            if (!parse_unsigned(value, UINT64_MAX, number)) {
+                return false;
+            }
+
+            options.seed = static_cast<std::uint64_t>(number);
+        } else if (std::strcmp(name, "--paddle") == 0) {
+            if (std::strcmp(value, "follow") == 0) {
+                options.paddle_control = PaddleControl::Follow;
+            } else if (std::strcmp(value, "sweep") == 0) {
+                options.paddle_control = PaddleControl::Sweep;
+            } else {
+                return false;
+            }
+        } else if (std::strcmp(name, "--max-time") == 0) {
+            if (!parse_float(value, options.max_time) || !(options.max_time > 0.0f)) {
+                return false;
+            }
+        } else {
+            return false;
+        }
+    }
+
+    return options.games > 0 && options.threads > 0;
+}
+
+int main(int argc, char** argv) {
+    Options options;
+
+    if (!parse_options(argc, argv, options)) {
+        print_usage();
+        return 1;
+    }
+
+    // Read once, instead of in every game
+    LevelDescription level;
+
+    if (!read_level(options.level, level)) {
+        std::printf("Could not load level `%s`\n", options.level.c_str());
+        return 1;
+    }
+
+    // Every game writes only its own result
+    std::vector<GameResult> results (options.games);
+
+    const auto begin {std::chrono::steady_clock::now()};
+
+    {
+        ThreadPool pool {options.threads};
+
+        for (std::size_t i {0}; i < options.games; i++) {
+            pool.submit([&options, &level, &results, i]() {
+                results[i] = play_game(options, level, options.seed + i);
+            });
+        }
+
+        pool.wait();
+    }
+
+    const double wall_time {std::chrono::duration<double>(std::chrono::steady_clock::now() - begin).count()};
+
+    print_report(options, results, wall_time);
+
+    return 0;
+}
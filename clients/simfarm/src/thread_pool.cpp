@@ -0,0 +1,110 @@
+#include "thread_pool.hpp"
+
+#include <utility>
+#include <cassert>
+
+ThreadPool::ThreadPool(unsigned int thread_count) {
+    assert(thread_count > 0);
+
+    for (unsigned int i {0}; i < thread_count; i++) {
+        queues.push_back(std::make_unique<Queue>());
+    }
+
+    for (unsigned int i {0}; i < thread_count; i++) {
+        threads.emplace_back(&ThreadPool::work, this, i);
+    }
+}
+
+ThreadPool::~ThreadPool() {
+    {
+        std::lock_guard<std::mutex> lock {mutex};
+        stop = true;
+    }
+
+    work_available.notify_all();
+
+    for (std::thread& thread : threads) {
+        thread.join();
+    }
+}
+
+void ThreadPool::submit(Task&& task) {
+    Queue& queue {*queues[next_queue]};
+    next_queue = (next_queue + 1) % queues.size();
+
+    pending++;
+
+    // Counted before it's pushed, so that the count never goes below zero
+    {
+        std::lock_guard<std::mutex> lock {mutex};
+        queued++;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock {queue.mutex};
+        queue.tasks.push_back(std::move(task));
+    }
+
+    work_available.notify_one();
+}
+
+void ThreadPool::wait() {
+    std::unique_lock<std::mutex> lock {mutex};
+    all_done.wait(lock, [this]() { return pending == 0; });
+}
+
+void ThreadPool::work(std::size_t index) {
+    while (true) {
+        Task task;
+
+        if (pop(index, task)) {
+            task();
+
+            if (--pending == 0) {
+                std::lock_guard<std::mutex> lock {mutex};
+                all_done.notify_all();
+            }
+
+            continue;
+        }
+
+        std::unique_lock<std::mutex> lock {mutex};
+        work_available.wait(lock, [this]() { return stop || queued > 0; });
+
+        if (stop && queued == 0) {
+            return;
+        }
+    }
+}
+
+bool ThreadPool::pop(std::size_t index, Task& task) {
+    // Own tasks are taken from the back, for locality
+    {
+        Queue& queue {*queues[index]};
+        std::lock_guard<std::mutex> lock {queue.mutex};
+
+        if (!queue.tasks.empty()) {
+            task = std::move(queue.tasks.back());
+            queue.tasks.pop_back();
+            queued--;
+
+            return true;
+        }
+    }
+
+    // And the tasks of others from the front
+    for (std::size_t i {1}; i < queues.size(); i++) {
+        Queue& queue {*queues[(index + i) % queues.size()]};
+        std::lock_guard<std::mutex> lock {queue.mutex};
+
+        if (!queue.tasks.empty()) {
+            task = std::move(queue.tasks.front());
+            queue.tasks.pop_front();
+            queued--;
+
+            return true;
+        }
+    }
+
+    return false;
+}
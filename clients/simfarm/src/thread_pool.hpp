@@ -0,0 +1,53 @@
+#pragma once
+
+#include <functional>
+#include <vector>
+#include <deque>
+#include <memory>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+#include <cstddef>
+
+// Every worker has its own queue of tasks and, when that is empty, steals from the others
+class ThreadPool {
+public:
+    using Task = std::function<void()>;
+
+    ThreadPool(unsigned int thread_count);
+    ~ThreadPool();
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+    ThreadPool(ThreadPool&&) = delete;
+    ThreadPool& operator=(ThreadPool&&) = delete;
+
+    void submit(Task&& task);
+
+    // Block until all the submitted tasks are done
+    void wait();
+
+    unsigned int get_thread_count() const { return static_cast<unsigned int>(threads.size()); }
+private:
+    struct Queue {
+        std::mutex mutex;
+        std::deque<Task> tasks;
+    };
+
+    void work(std::size_t index);
+    bool pop(std::size_t index, Task& task);
+
+    std::vector<std::unique_ptr<Queue>> queues;
+    std::vector<std::thread> threads;
+    std::size_t next_queue {0};
+
+    std::atomic<std::size_t> queued {0};  // Not yet taken by any worker
+    std::atomic<std::size_t> pending {0};  // Not yet finished
+
+    // For sleeping when there is nothing to do
+    std::mutex mutex;
+    std::condition_variable work_available;
+    std::condition_variable all_done;
+    bool stop {false};
+};
@@ -1,4 +1,6 @@
 #include <memory>
+#include <cstring>
+#include <cstdlib>
 
 #include <engine/engine.hpp>
 #include <resmanager/resmanager.hpp>
@@ -12,7 +14,7 @@ struct MainScene : public bb::Scene {
         : bb::Scene("main") {}
 
     virtual void on_enter() override {
-        bb::log_message("Entered main scene\n");
+        BB_LOG_INFO(General, "Entered main scene\n");
 
         connect_event<bb::KeyPressedEvent, &MainScene::on_key_pressed>(this);
         connect_event<bb::KeyReleasedEvent, &MainScene::on_key_released>(this);
@@ -95,7 +97,7 @@ struct MainScene : public bb::Scene {
     }
 
     virtual void on_exit() override {
-        bb::log_message("Exited main scene\n");
+        BB_LOG_INFO(General, "Exited main scene\n");
     }
 
     virtual void on_update() override {
@@ -125,15 +127,15 @@ struct MainScene : public bb::Scene {
     }
 
     void on_key_pressed(const bb::KeyPressedEvent& event) {
-        bb::log_message("KeyPressed: %d\n", static_cast<int>(event.key));
+        BB_LOG_DEBUG(General, "KeyPressed: %d\n", static_cast<int>(event.key));
 
         if (event.key == bb::KeyCode::K_f) {
-            bb::log_message("%f - %f\n", get_delta(), get_fps());
+            BB_LOG_DEBUG(General, "%f - %f\n", get_delta(), get_fps());
         }
     }
 
     void on_key_released(const bb::KeyReleasedEvent& event) {
-        bb::log_message("KeyReleased: %d\n", static_cast<int>(event.key));
+        BB_LOG_DEBUG(General, "KeyReleased: %d\n", static_cast<int>(event.key));
 
         static bool enabled {true};
 
@@ -144,23 +146,23 @@ struct MainScene : public bb::Scene {
     }
 
     void on_mouse_moved(const bb::MouseMovedEvent& event) {
-        bb::log_message("MouseMoved: %dx%d\n", event.x, event.y);
+        BB_LOG_DEBUG(General, "MouseMoved: %dx%d\n", event.x, event.y);
     }
 
     void on_mouse_button_pressed(const bb::MouseButtonPressedEvent& event) {
-        bb::log_message("MouseButtonPressed: %d\n", static_cast<int>(event.button));
+        BB_LOG_DEBUG(General, "MouseButtonPressed: %d\n", static_cast<int>(event.button));
     }
 
     void on_mouse_button_released(const bb::MouseButtonReleasedEvent& event) {
-        bb::log_message("MouseButtonReleased: %d\n", static_cast<int>(event.button));
+        BB_LOG_DEBUG(General, "MouseButtonReleased: %d\n", static_cast<int>(event.button));
     }
 
     void on_mouse_wheel_scrolled(const bb::MouseWheelScrolledEvent& event) {
-        bb::log_message("MouseWheelScrolled: %d\n", event.scroll);
+        BB_LOG_DEBUG(General, "MouseWheelScrolled: %d\n", event.scroll);
     }
 
     void on_window_resized(const bb::WindowResizedEvent& event) {
-        bb::log_message("WindowResized: %dx%d\n", event.width, event.height);
+        BB_LOG_DEBUG(General, "WindowResized: %dx%d\n", event.width, event.height);
 
         cam.set_projection_matrix(event.width, event.height, LENS_FOV, LENS_NEAR, LENS_FAR);
     }
@@ -179,15 +181,28 @@ struct MainScene : public bb::Scene {
     float teapot_position_y {0.0f};
 };
 
-int main() {
+int main(int argc, char** argv) {
     bb::ApplicationProperties properties;
 
+    // Runs headless for a number of frames, for measuring and for comparing screenshots
+    for (int i {1}; i < argc; i++) {
+        if (std::strcmp(argv[i], "--headless") == 0) {
+            properties.headless = true;
+        } else if (i + 1 == argc) {
+            break;
+        } else if (std::strcmp(argv[i], "--frames") == 0) {
+            properties.frame_limit = std::atoi(argv[++i]);
+        } else if (std::strcmp(argv[i], "--screenshot") == 0) {
+            properties.screenshot_file = argv[++i];
+        }
+    }
+
     try {
         bb::Application application {properties};
         application.add_scene<MainScene>();
         application.run("main");
     } catch (bb::RuntimeError error) {
-        bb::log_message("An error occurred: %d\n", error);
+        BB_LOG_ERROR(General, "An error occurred: %d\n", error);
         return 1;
     }
 
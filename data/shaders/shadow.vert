@@ -1,13 +1,12 @@
 #version 430 core
 
 layout(location = 0) in vec3 a_position;
-
-uniform mat4 u_model_matrix;
+layout(location = 8) in mat4 a_model_matrix;  // Per instance
 
 layout(shared, binding = 4) uniform LightSpace {
     mat4 u_light_space_matrix;
 };
 
 void main() {
-    gl_Position = u_light_space_matrix * u_model_matrix * vec4(a_position, 1.0);
+    gl_Position = u_light_space_matrix * a_model_matrix * vec4(a_position, 1.0);
 }
@@ -3,6 +3,8 @@
 #include <vector>
 #include <cassert>
 #include <algorithm>
+#include <cstdint>
+#include <ctime>
 
 #include "engine/events.hpp"
 #include "engine/window.hpp"
@@ -12,9 +14,16 @@
 #include "engine/application.hpp"
 #include "engine/info_and_debug.hpp"
 #include "engine/logging.hpp"
+#include "engine/profiler.hpp"
+#include "engine/input.hpp"
+#include "engine/render_capture.hpp"
 
 namespace bb {
     Application::Application(const ApplicationProperties& properties) {
+        if (!properties.log_file.empty()) {
+            set_log_file(properties.log_file);
+        }
+
         WindowProperties window_properties;
         window_properties.width = properties.width;
         window_properties.height = properties.height;
@@ -22,6 +31,7 @@ namespace bb {
         window_properties.fullscreen = properties.fullscreen;
         window_properties.min_width = properties.min_width;
         window_properties.min_height = properties.min_height;
+        window_properties.headless = properties.headless;
 
         window = std::make_unique<Window>(window_properties, this);
         renderer = std::make_unique<Renderer>(properties.width, properties.height, properties.samples);
@@ -34,10 +44,53 @@ namespace bb {
 
         events.connect<WindowClosedEvent, &Application::on_window_closed>(this);
         events.connect<WindowResizedEvent, &Application::on_window_resized>(this);
+        events.connect<KeyPressedEvent, &Application::on_performance_overlay_key_pressed>(this);
+        events.connect<KeyPressedEvent, &Application::on_render_capture_key_pressed>(this);
 
         user_data = properties.user_data;
+        render_capture_file_path = properties.render_capture_file;
+        frames_left = properties.frame_limit;
+        screenshot_file_path = properties.screenshot_file;
+
+        assert(properties.fixed_update_rate > 0);
+        fixed_dt = 1.0 / static_cast<double>(properties.fixed_update_rate);
+
+        if (!properties.replay_input_file.empty()) {
+            replay = std::make_unique<InputRecording>();
+            replay->load(properties.replay_input_file);
+
+            // The input comes from the file only
+            window->set_input_enabled(false);
+
+            seed = replay->get_seed();
+        } else {
+            seed = static_cast<unsigned int>(std::time(nullptr));
+
+            if (!properties.record_input_file.empty()) {
+                recording = std::make_unique<InputRecording>(seed);
+                recording_file_path = properties.record_input_file;
+
+                events.connect<KeyPressedEvent, &Application::on_key_pressed>(this);
+                events.connect<KeyReleasedEvent, &Application::on_key_released>(this);
+                events.connect<MouseMovedEvent, &Application::on_mouse_moved>(this);
+                events.connect<MouseButtonPressedEvent, &Application::on_mouse_button_pressed>(this);
+                events.connect<MouseButtonReleasedEvent, &Application::on_mouse_button_released>(this);
+                events.connect<MouseWheelScrolledEvent, &Application::on_mouse_wheel_scrolled>(this);
+            }
+        }
 
-        log_message("Initialized application\n");
+#ifdef BB_PROFILE
+        profile_file_path = properties.profile_file;
+
+        events.connect<KeyPressedEvent, &Application::on_profile_key_pressed>(this);
+
+        if (properties.profile_frames > 0) {
+            profile_frames_left = properties.profile_frames;
+            Profiler::begin_capture();
+        }
+#endif
+
+        BB_LOG_INFO(Application, "Initialized application\n");
     }
 
     Application::~Application() {
@@ -48,7 +101,7 @@ namespace bb {
 
         AudioManager::uninitialize();
 
-        log_message("Destroyed application\n");
+        BB_LOG_INFO(Application, "Destroyed application\n");
     }
 
     void Application::run(const std::string& scene_name) {
@@ -58,28 +111,138 @@ namespace bb {
         renderer->prerender_setup();
 
         while (running) {
+            BB_PROFILE_SCOPE("frame");
+
+            const std::uint64_t frame_begin {Profiler::get_time()};
+
             dt = calculate_delta();
+            frame_counts = FrameCounters::reset();
+
+            {
+                BB_PROFILE_SCOPE("poll_events");
+                window->poll_events();
+            }
+
+            if (replay != nullptr && !replay_frame()) {
+                BB_LOG_INFO(Application, "Finished replaying input\n");
+                running = false;
+
+                continue;
+            }
+
+            if (recording != nullptr) {
+                recording->begin_frame(dt);
+            }
+
+            const std::uint64_t update_begin {Profiler::get_time()};
+
+            accumulator += static_cast<double>(dt);
+
+            while (accumulator >= fixed_dt) {
+                {
+                    BB_PROFILE_SCOPE("on_fixed_update");
+                    current_scene->on_fixed_update();
+                }
+                {
+                    BB_PROFILE_SCOPE("events.update");
+                    events.update();
+                }
+
+                accumulator -= fixed_dt;
+            }
+
+            // How far we are between the previous and the current simulation state
+            alpha = static_cast<float>(accumulator / fixed_dt);
+
+            {
+                BB_PROFILE_SCOPE("on_update");
+                current_scene->on_update();
+            }
+            {
+                BB_PROFILE_SCOPE("events.update");
+                events.update();
+            }
+
+            const std::uint64_t render_begin {Profiler::get_time()};
 
-            window->poll_events();
+            {
+                BB_PROFILE_SCOPE("render");
 
-            current_scene->on_update();
-            events.update();
+                if (performance_overlay.is_visible()) {
+                    performance_overlay.draw(
+                        *renderer,
+                        frame_statistics,
+                        frame_counts,
+                        window->get_width(),
+                        window->get_height()
+                    );
+                }
 
-            renderer->render();
+                renderer->add_renderables(current_scene->registry);
 
-            window->refresh();
+                if (render_capture_requested) {
+                    take_render_capture();
+                }
+
+                renderer->render();
+            }
+
+            const std::uint64_t render_end {Profiler::get_time()};
+
+            if (frames_left > 0 && --frames_left == 0) {
+                if (!screenshot_file_path.empty() && window->save_frame(screenshot_file_path)) {
+                    BB_LOG_INFO(Application, "Saved screenshot `%s`\n", screenshot_file_path.c_str());
+                }
+
+                running = false;
+            }
+
+            {
+                BB_PROFILE_SCOPE("refresh");
+                window->refresh();
+            }
 
             check_scene_change();
+
+            // Scene changes load levels and resources, which are the longest stalls, so they count too
+            frame_statistics.add_frame(
+                nanoseconds_to_milliseconds(Profiler::get_time() - frame_begin),
+                nanoseconds_to_milliseconds(render_begin - update_begin),
+                nanoseconds_to_milliseconds(render_end - render_begin)
+            );
+
+#ifdef BB_PROFILE
+            if (profile_frames_left > 0 && --profile_frames_left == 0) {
+                end_profile_capture();
+            }
+#endif
+        }
+
+#ifdef BB_PROFILE
+        if (Profiler::is_capturing()) {
+            end_profile_capture();
         }
+#endif
 
         renderer->postrender_setup();
         current_scene->on_exit();
+
+        if (recording != nullptr) {
+            recording->save(recording_file_path);
+        }
+
+        log_frame_statistics();
     }
 
     void Application::setup_scenes(const std::string& scene_name) {
+        std::uint64_t index {0u};
+
         for (Scene* scene : scenes) {
             scene->application = this;
 
+            // Every scene has its own sequence of random numbers
+            scene->random.seed(static_cast<std::uint64_t>(seed) << 32u | index++);
+
             if (scene->name == scene_name) {
                 current_scene = scene;
             }
@@ -97,6 +260,9 @@ namespace bb {
             current_scene = next_scene;
             next_scene = nullptr;
 
+            accumulator = 0.0;
+            alpha = 0.0f;
+
             current_scene->on_enter();
             renderer->prerender_setup();
         }
@@ -137,6 +303,91 @@ namespace bb {
         return static_cast<float>(delta_time);
     }
 
+    void Application::log_frame_statistics() const {
+        const FrameStatisticsSummary summary {frame_statistics.calculate_total()};
+
+        if (summary.frames == 0) {
+            return;
+        }
+
+        BB_LOG_INFO(
+            Application,
+            "Frame times of %zu frames (ms): min %.2f, avg %.2f, p50 %.2f, p95 %.2f, p99 %.2f, max %.2f\n",
+            summary.frames,
+            summary.min,
+            summary.avg,
+            summary.p50,
+            summary.p95,
+            summary.p99,
+            summary.max
+        );
+
+        BB_LOG_INFO(
+            Application,
+            "Average update %.2f ms, average render %.2f ms, %zu hitches\n",
+            summary.avg_update,
+            summary.avg_render,
+            summary.hitches
+        );
+    }
+
+    bool Application::replay_frame() {
+        const RecordedFrame* frame {replay->next_frame()};
+
+        if (frame == nullptr) {
+            return false;
+        }
+
+        // Time passes exactly as it did
+        dt = frame->dt;
+
+        for (const RecordedEvent& event : frame->events) {
+            const int* v {event.values};
+
+            switch (event.type) {
+                case RecordedEvent::Type::KeyPressed:
+                    events.enqueue<KeyPressedEvent>(static_cast<KeyCode>(v[0]), static_cast<bool>(v[1]));
+                    break;
+                case RecordedEvent::Type::KeyReleased:
+                    events.enqueue<KeyReleasedEvent>(static_cast<KeyCode>(v[0]));
+                    break;
+                case RecordedEvent::Type::MouseMoved:
+                    events.enqueue<MouseMovedEvent>(static_cast<unsigned int>(v[0]), v[1], v[2], v[3], v[4]);
+                    break;
+                case RecordedEvent::Type::MouseButtonPressed:
+                    events.enqueue<MouseButtonPressedEvent>(static_cast<unsigned char>(v[0]), v[1], v[2]);
+                    break;
+                case RecordedEvent::Type::MouseButtonReleased:
+                    events.enqueue<MouseButtonReleasedEvent>(static_cast<unsigned char>(v[0]), v[1], v[2]);
+                    break;
+                case RecordedEvent::Type::MouseWheelScrolled:
+                    events.enqueue<MouseWheelScrolledEvent>(v[0]);
+                    break;
+            }
+        }
+
+        return true;
+    }
+
+    void Application::end_profile_capture() {
+        if (Profiler::end_capture(profile_file_path)) {
+            BB_LOG_INFO(Application, "Saved profile capture `%s`\n", profile_file_path.c_str());
+        } else {
+            BB_LOG_ERROR(Application, "Could not write profile capture `%s`\n", profile_file_path.c_str());
+        }
+    }
+
+    void Application::take_render_capture() {
+        render_capture_requested = false;
+
+        RenderCapture capture;
+        capture.take(*renderer);
+
+        if (!capture.save(render_capture_file_path)) {
+            BB_LOG_ERROR(Application, "Could not take render capture\n");
+        }
+    }
+
     void Application::on_window_closed(const WindowClosedEvent&) {
         running = false;
     }
@@ -144,4 +395,95 @@ namespace bb {
     void Application::on_window_resized(const WindowResizedEvent& event) {
         renderer->resize_framebuffers(event.width, event.height);
     }
+
+    void Application::on_profile_key_pressed(const KeyPressedEvent& event) {
+        if (event.key != KeyCode::K_F9 || event.repeat) {
+            return;
+        }
+
+        profile_frames_left = 0;
+
+        if (Profiler::is_capturing()) {
+            end_profile_capture();
+        } else {
+            BB_LOG_INFO(Application, "Started profile capture\n");
+            Profiler::begin_capture();
+        }
+    }
+
+    void Application::on_performance_overlay_key_pressed(const KeyPressedEvent& event) {
+        if (event.key != KeyCode::K_F3 || event.repeat) {
+            return;
+        }
+
+        performance_overlay.set_visible(!performance_overlay.is_visible());
+
+        // The timings of the render passes are shown too
+        renderer->set_gpu_timing(performance_overlay.is_visible());
+    }
+
+    void Application::on_render_capture_key_pressed(const KeyPressedEvent& event) {
+        if (event.key != KeyCode::K_F10 || event.repeat) {
+            return;
+        }
+
+        render_capture_requested = true;
+    }
+
+    void Application::on_key_pressed(const KeyPressedEvent& event) {
+        RecordedEvent recorded;
+        recorded.type = RecordedEvent::Type::KeyPressed;
+        recorded.values[0] = static_cast<int>(event.key);
+        recorded.values[1] = static_cast<int>(event.repeat);
+
+        recording->add_event(recorded);
+    }
+
+    void Application::on_key_released(const KeyReleasedEvent& event) {
+        RecordedEvent recorded;
+        recorded.type = RecordedEvent::Type::KeyReleased;
+        recorded.values[0] = static_cast<int>(event.key);
+
+        recording->add_event(recorded);
+    }
+
+    void Application::on_mouse_moved(const MouseMovedEvent& event) {
+        RecordedEvent recorded;
+        recorded.type = RecordedEvent::Type::MouseMoved;
+        recorded.values[0] = static_cast<int>(event.buttons);
+        recorded.values[1] = event.x;
+        recorded.values[2] = event.y;
+        recorded.values[3] = event.xrel;
+        recorded.values[4] = event.yrel;
+
+        recording->add_event(recorded);
+    }
+
+    void Application::on_mouse_button_pressed(const MouseButtonPressedEvent& event) {
+        RecordedEvent recorded;
+        recorded.type = RecordedEvent::Type::MouseButtonPressed;
+        recorded.values[0] = static_cast<int>(event.button);
+        recorded.values[1] = event.x;
+        recorded.values[2] = event.y;
+
+        recording->add_event(recorded);
+    }
+
+    void Application::on_mouse_button_released(const MouseButtonReleasedEvent& event) {
+        RecordedEvent recorded;
+        recorded.type = RecordedEvent::Type::MouseButtonReleased;
+        recorded.values[0] = static_cast<int>(event.button);
+        recorded.values[1] = event.x;
+        recorded.values[2] = event.y;
+
+        recording->add_event(recorded);
+    }
+
+    void Application::on_mouse_wheel_scrolled(const MouseWheelScrolledEvent& event) {
+        RecordedEvent recorded;
+        recorded.type = RecordedEvent::Type::MouseWheelScrolled;
+        recorded.values[0] = event.scroll;
+
+        recording->add_event(recorded);
+    }
 }
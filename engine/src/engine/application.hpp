@@ -9,6 +9,10 @@
 #include "engine/window.hpp"
 #include "engine/application_properties.hpp"
 #include "engine/renderer.hpp"
+#include "engine/input_recording.hpp"
+#include "engine/frame_statistics.hpp"
+#include "engine/frame_counters.hpp"
+#include "engine/performance_overlay.hpp"
 
 namespace bb {
     class Scene;
@@ -34,9 +38,22 @@ namespace bb {
         void check_scene_change();
         void change_scene(const std::string& scene_name);
         float calculate_delta();
+        bool replay_frame();
+        void end_profile_capture();
+        void take_render_capture();
+        void log_frame_statistics() const;
 
         void on_window_closed(const WindowClosedEvent&);
         void on_window_resized(const WindowResizedEvent& event);
+        void on_profile_key_pressed(const KeyPressedEvent& event);
+        void on_performance_overlay_key_pressed(const KeyPressedEvent& event);
+        void on_render_capture_key_pressed(const KeyPressedEvent& event);
+        void on_key_pressed(const KeyPressedEvent& event);
+        void on_key_released(const KeyReleasedEvent& event);
+        void on_mouse_moved(const MouseMovedEvent& event);
+        void on_mouse_button_pressed(const MouseButtonPressedEvent& event);
+        void on_mouse_button_released(const MouseButtonReleasedEvent& event);
+        void on_mouse_wheel_scrolled(const MouseWheelScrolledEvent& event);
 
         EventSystem events;
         std::unique_ptr<Window> window;
@@ -46,6 +63,37 @@ namespace bb {
         float dt {0.0f};
         double fps {0.0};
 
+        // Every frame is timed, for percentiles and hitches, which an average hides
+        FrameStatistics frame_statistics;
+
+        // Of the previous frame, as the current one is still going; shown in the overlay, which is toggled with F3
+        FrameCounts frame_counts;
+        PerformanceOverlay performance_overlay;
+
+        // Simulation runs at a fixed rate, independent of rendering
+        double fixed_dt {0.0};
+        double accumulator {0.0};
+        float alpha {0.0f};
+
+        // Seed of the random number generators of the scenes, recorded or replayed with the input
+        unsigned int seed {0u};
+
+        std::unique_ptr<InputRecording> recording;
+        std::unique_ptr<InputRecording> replay;
+        std::string recording_file_path;
+
+        // Profiling captures are toggled with F9, or taken at the start for a number of frames
+        std::string profile_file_path;
+        int profile_frames_left {0};
+
+        // Render captures are requested with F10 and taken just before rendering
+        std::string render_capture_file_path;
+        bool render_capture_requested {false};
+
+        // Runs end after a number of frames, if set, leaving a screenshot behind for comparison
+        int frames_left {0};
+        std::string screenshot_file_path;
+
         std::vector<Scene*> scenes;
         Scene* current_scene {nullptr};
         Scene* next_scene {nullptr};
@@ -13,5 +13,15 @@ namespace bb {
         int min_width {640};
         int min_height {360};
         int samples {1};
+        int fixed_update_rate {120};  // Hz
+        std::string record_input_file;  // Record the session into this file, if not empty
+        std::string replay_input_file;  // Replay the session from this file, if not empty
+        std::string log_file;  // Log into this file instead of the standard output, if not empty
+        std::string profile_file {"profile.json"};  // Where profiling captures are written, with BB_PROFILE
+        int profile_frames {0};  // Capture this many frames from the start, if not 0
+        std::string render_capture_file {"render_capture.bbrc"};  // Where render captures are written
+        bool headless {false};  // Render offscreen, without a window; the frame limit usually goes with it
+        int frame_limit {0};  // Quit after this many frames, if not 0
+        std::string screenshot_file;  // Save the frame at the frame limit as PNG into this file, if not empty
     };
 }
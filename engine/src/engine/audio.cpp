@@ -10,12 +10,12 @@ namespace bb {
         Mix_Init(0);
 
         if (Mix_OpenAudio(44100, AUDIO_S16, 1, 2048) < 0) {
-            log_message("Could not open audio device\n");
+            BB_LOG_ERROR(Audio, "Could not open audio device\n");
             throw InitializationError;
         }
 
         if (Mix_AllocateChannels(8) != 8) {
-            log_message("Could not allocate all channels\n");
+            BB_LOG_ERROR(Audio, "Could not allocate all channels\n");
         }
     }
 
@@ -8,6 +8,7 @@
 #include <glad/glad.h>
 
 #include "engine/buffer.hpp"
+#include "engine/frame_counters.hpp"
 
 namespace bb {
     static int draw_hint_to_int(DrawHint hint) {
@@ -52,6 +53,8 @@ namespace bb {
         glBufferData(GL_ARRAY_BUFFER, size, data, draw_hint_to_int(hint));
 
         glBindBuffer(GL_ARRAY_BUFFER, 0);
+
+        FrameCounters::count_upload(size);
     }
 
     VertexBuffer::~VertexBuffer() {
@@ -68,10 +71,14 @@ namespace bb {
 
     void VertexBuffer::upload_data(const void* data, std::size_t size) const {
         glBufferData(GL_ARRAY_BUFFER, size, data, draw_hint_to_int(hint));
+
+        FrameCounters::count_upload(size);
     }
 
     void VertexBuffer::upload_sub_data(const void* data, std::size_t offset, std::size_t size) const {
         glBufferSubData(GL_ARRAY_BUFFER, offset, size, data);
+
+        FrameCounters::count_upload(size);
     }
 
     IndexBuffer::IndexBuffer(const void* data, std::size_t size) {
@@ -81,6 +88,8 @@ namespace bb {
 
         glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
 
+        FrameCounters::count_upload(size);
+
         assert(size % sizeof(unsigned int) == 0);
 
         index_count = static_cast<int>(size / sizeof(unsigned int));
@@ -198,6 +207,8 @@ namespace bb {
         assert(data != nullptr && size > 0);
 
         glBufferSubData(GL_UNIFORM_BUFFER, 0, size, data);
+
+        FrameCounters::count_upload(size);
     }
 
     void UniformBuffer::set_and_upload(const void* field_data, Key field) {
@@ -209,6 +220,8 @@ namespace bb {
 
         std::memcpy(data + offset, field_data, size);
         glBufferSubData(GL_UNIFORM_BUFFER, offset, size, data);
+
+        FrameCounters::count_upload(size);
     }
 
     void UniformBuffer::allocate_memory(std::size_t size) {
@@ -33,6 +33,8 @@ namespace bb {
     private:
         unsigned int buffer {0};
         DrawHint hint {DrawHint::Static};
+
+        friend class RenderCapture;
     };
 
     // Only supports unsigned int
@@ -53,6 +55,8 @@ namespace bb {
     private:
         unsigned int buffer {0};
         int index_count {0};
+
+        friend class RenderCapture;
     };
 
     struct UniformBlockSpecification {
@@ -12,16 +12,25 @@
 #include "engine/engine.hpp"
 #include "engine/events.hpp"
 #include "engine/font.hpp"
+#include "engine/frame_counters.hpp"
+#include "engine/frame_statistics.hpp"
 #include "engine/framebuffer.hpp"
+#include "engine/gpu_timer.hpp"
 #include "engine/info_and_debug.hpp"
 #include "engine/input.hpp"
+#include "engine/input_recording.hpp"
 #include "engine/light.hpp"
 #include "engine/logging.hpp"
 #include "engine/material.hpp"
 #include "engine/mesh.hpp"
 #include "engine/opengl.hpp"
 #include "engine/panic.hpp"
+#include "engine/performance_overlay.hpp"
 #include "engine/post_processing.hpp"
+#include "engine/profiler.hpp"
+#include "engine/random.hpp"
+#include "engine/render_capture.hpp"
+#include "engine/render_queue.hpp"
 #include "engine/renderable.hpp"
 #include "engine/renderer.hpp"
 #include "engine/scene.hpp"
@@ -29,6 +38,7 @@
 #include "engine/sound_data.hpp"
 #include "engine/texture_data.hpp"
 #include "engine/texture.hpp"
+#include "engine/transform_stage.hpp"
 #include "engine/vertex_array.hpp"
 #include "engine/vertex_buffer_layout.hpp"
 #include "engine/window.hpp"
@@ -28,7 +28,7 @@ namespace bb {
         std::ifstream file {file_path, std::ios::binary};
 
         if (!file.is_open()) {
-            log_message("Could not open file `%s` for reading\n", file_path.c_str());
+            BB_LOG_ERROR(Resources, "Could not open file `%s` for reading\n", file_path.c_str());
             throw ResourceLoadingError;
         }
 
@@ -80,11 +80,12 @@ namespace bb {
         int pixel_dist_scale,
         int bitmap_size
     )
-        : bitmap_size(bitmap_size), padding(padding), on_edge_value(on_edge_value), pixel_dist_scale(pixel_dist_scale) {
+        : bitmap_size(bitmap_size), padding(padding), on_edge_value(on_edge_value), pixel_dist_scale(pixel_dist_scale),
+          file_path(file_path), font_size(size) {
         const auto contents {read_file(file_path)};
 
         if (!contents) {
-            log_message("Could not open file `%s` for reading\n", file_path.c_str());
+            BB_LOG_ERROR(Resources, "Could not open file `%s` for reading\n", file_path.c_str());
             throw ResourceLoadingError;
         }
 
@@ -92,7 +93,7 @@ namespace bb {
         font_info = new stbtt_fontinfo;
 
         if (!stbtt_InitFont(font_info, font_info_buffer, 0)) {
-            log_message("Could not load font `%s`\n", file_path.c_str());
+            BB_LOG_ERROR(Resources, "Could not load font `%s`\n", file_path.c_str());
             throw ResourceLoadingError;
         }
 
@@ -259,7 +260,7 @@ namespace bb {
 
     void Font::try_bake_character(int codepoint, int descent) {
         if (glyphs.count(codepoint) > 0) {
-            log_message("Character with codepoint `%d` is already baked\n");
+            BB_LOG_WARNING(Resources, "Character with codepoint `%d` is already baked\n", codepoint);
             return;
         }
 
@@ -287,7 +288,7 @@ namespace bb {
         )};
 
         if (glyph == nullptr) {
-            log_message("Could not bake character with codepoint `%d`; still adding to map...\n", codepoint);
+            BB_LOG_WARNING(Resources, "Could not bake character with codepoint `%d`; still adding to map...\n", codepoint);
         }
 
         if (bake_context.x + width > bitmap_size) {
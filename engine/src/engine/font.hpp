@@ -88,5 +88,11 @@ namespace bb {
         std::weak_ptr<VertexBuffer> buffer;
 
         int vertex_count {0};
+
+        // Arguments of the constructor, for render captures
+        std::string file_path;
+        float font_size {0.0f};
+
+        friend class RenderCapture;
     };
 }
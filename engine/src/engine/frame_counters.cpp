@@ -0,0 +1,65 @@
+#include <atomic>
+#include <new>
+#include <cstdlib>
+
+#include "engine/frame_counters.hpp"
+
+namespace bb {
+    static std::atomic<std::uint64_t> draw_calls {0};
+    static std::atomic<std::uint64_t> binds {0};
+    static std::atomic<std::uint64_t> uploaded_bytes {0};
+    static std::atomic<std::uint64_t> allocations {0};
+    static std::atomic<std::uint64_t> allocated_bytes {0};
+
+    void FrameCounters::count_draw_call() {
+        draw_calls.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    void FrameCounters::count_bind() {
+        binds.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    void FrameCounters::count_upload(std::size_t bytes) {
+        uploaded_bytes.fetch_add(bytes, std::memory_order_relaxed);
+    }
+
+    FrameCounts FrameCounters::reset() {
+        FrameCounts counts;
+        counts.draw_calls = draw_calls.exchange(0, std::memory_order_relaxed);
+        counts.binds = binds.exchange(0, std::memory_order_relaxed);
+        counts.uploaded_bytes = uploaded_bytes.exchange(0, std::memory_order_relaxed);
+        counts.allocations = allocations.exchange(0, std::memory_order_relaxed);
+        counts.allocated_bytes = allocated_bytes.exchange(0, std::memory_order_relaxed);
+
+        return counts;
+    }
+}
+
+// Replacing these is enough, as the array and the nothrow versions call them
+
+void* operator new(std::size_t size) {
+    bb::allocations.fetch_add(1, std::memory_order_relaxed);
+    bb::allocated_bytes.fetch_add(size, std::memory_order_relaxed);
+
+    void* pointer {nullptr};
+
+    while ((pointer = std::malloc(size == 0 ? 1 : size)) == nullptr) {
+        const std::new_handler handler {std::get_new_handler()};
+
+        if (handler == nullptr) {
+            throw std::bad_alloc();
+        }
+
+        handler();
+    }
+
+    return pointer;
+}
+
+void operator delete(void* pointer) noexcept {
+    std::free(pointer);
+}
+
+void operator delete(void* pointer, std::size_t) noexcept {
+    std::free(pointer);
+}
@@ -0,0 +1,26 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+namespace bb {
+    // What happened during a frame, on all threads
+    struct FrameCounts {
+        std::uint64_t draw_calls {0};
+        std::uint64_t binds {0};  // Of shaders and vertex arrays
+        std::uint64_t uploaded_bytes {0};  // To the GPU
+        std::uint64_t allocations {0};  // With operator new, except the over-aligned ones
+        std::uint64_t allocated_bytes {0};
+    };
+
+    // Counting is cheap enough to be always on, so that release builds can be diagnosed too
+    class FrameCounters {
+    public:
+        static void count_draw_call();
+        static void count_bind();
+        static void count_upload(std::size_t bytes);
+
+        // Return what was counted since the last reset and start over
+        static FrameCounts reset();
+    };
+}
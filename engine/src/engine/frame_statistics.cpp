@@ -0,0 +1,133 @@
+#include "engine/frame_statistics.hpp"
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+
+namespace bb {
+    // Too few frames give a meaningless average to compare against
+    static constexpr std::size_t MIN_HITCH_FRAMES {16};
+
+    // Nearest rank
+    static std::size_t percentile_rank(float percentile, std::size_t count) {
+        const auto rank {static_cast<std::size_t>(std::ceil(percentile * static_cast<float>(count)))};
+
+        return std::max(rank, std::size_t(1)) - 1;
+    }
+
+    void FrameStatistics::add_frame(float total, float update, float render) {
+        FrameTime frame;
+        frame.total = total;
+        frame.update = update;
+        frame.render = render;
+
+        if (count >= MIN_HITCH_FRAMES) {
+            const double average {window_total / static_cast<double>(count)};
+            frame.hitch = static_cast<double>(total) > average * static_cast<double>(HITCH_FACTOR);
+        }
+
+        // The oldest frame is overwritten once the ring is full
+        if (count == CAPACITY) {
+            window_total -= static_cast<double>(frames[next].total);
+        } else {
+            count++;
+        }
+
+        frames[next] = frame;
+        next = (next + 1) % CAPACITY;
+        window_total += static_cast<double>(total);
+
+        const auto bucket {static_cast<std::size_t>(std::max(total, 0.0f) / BUCKET_SIZE)};
+        histogram[std::min(bucket, BUCKETS - 1)]++;
+
+        total_time += static_cast<double>(total);
+        total_update += static_cast<double>(update);
+        total_render += static_cast<double>(render);
+        total_min = total_frames == 0 ? total : std::min(total_min, total);
+        total_max = total_frames == 0 ? total : std::max(total_max, total);
+        total_hitches += static_cast<std::size_t>(frame.hitch);
+        total_frames++;
+    }
+
+    FrameStatisticsSummary FrameStatistics::calculate(std::size_t last) const {
+        FrameStatisticsSummary summary;
+        summary.frames = std::min(last, count);
+
+        if (summary.frames == 0) {
+            return summary;
+        }
+
+        std::array<float, CAPACITY> totals;
+        double sum {0.0};
+        double sum_update {0.0};
+        double sum_render {0.0};
+
+        for (std::size_t i {0}; i < summary.frames; i++) {
+            const FrameTime& frame {get_frame(i)};
+
+            totals[i] = frame.total;
+            sum += static_cast<double>(frame.total);
+            sum_update += static_cast<double>(frame.update);
+            sum_render += static_cast<double>(frame.render);
+            summary.hitches += static_cast<std::size_t>(frame.hitch);
+        }
+
+        std::sort(totals.begin(), totals.begin() + summary.frames);
+
+        const auto frame_count {static_cast<double>(summary.frames)};
+
+        summary.min = totals[0];
+        summary.max = totals[summary.frames - 1];
+        summary.avg = static_cast<float>(sum / frame_count);
+        summary.p50 = totals[percentile_rank(0.50f, summary.frames)];
+        summary.p95 = totals[percentile_rank(0.95f, summary.frames)];
+        summary.p99 = totals[percentile_rank(0.99f, summary.frames)];
+        summary.avg_update = static_cast<float>(sum_update / frame_count);
+        summary.avg_render = static_cast<float>(sum_render / frame_count);
+
+        return summary;
+    }
+
+    FrameStatisticsSummary FrameStatistics::calculate_total() const {
+        FrameStatisticsSummary summary;
+        summary.frames = total_frames;
+
+        if (summary.frames == 0) {
+            return summary;
+        }
+
+        const auto frame_count {static_cast<double>(summary.frames)};
+
+        summary.min = total_min;
+        summary.max = total_max;
+        summary.avg = static_cast<float>(total_time / frame_count);
+        summary.avg_update = static_cast<float>(total_update / frame_count);
+        summary.avg_render = static_cast<float>(total_render / frame_count);
+        summary.hitches = total_hitches;
+
+        // Percentiles are the upper bounds of the buckets they fall in, but never more than the maximum
+        const float percentiles[] {0.50f, 0.95f, 0.99f};
+        float* results[] {&summary.p50, &summary.p95, &summary.p99};
+
+        std::size_t seen {0};
+        std::size_t bucket {0};
+
+        for (std::size_t i {0}; i < 3; i++) {
+            const std::size_t rank {percentile_rank(percentiles[i], summary.frames)};
+
+            while (seen + histogram[bucket] <= rank) {
+                seen += histogram[bucket++];
+            }
+
+            *results[i] = std::min(static_cast<float>(bucket + 1) * BUCKET_SIZE, total_max);
+        }
+
+        return summary;
+    }
+
+    const FrameTime& FrameStatistics::get_frame(std::size_t age) const {
+        assert(age < count);
+
+        return frames[(next + CAPACITY - 1 - age) % CAPACITY];
+    }
+}
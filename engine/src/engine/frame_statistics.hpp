@@ -0,0 +1,68 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+namespace bb {
+    // Times of one frame, in milliseconds
+    struct FrameTime {
+        float total {0.0f};
+        float update {0.0f};  // Fixed updates, update and events
+        float render {0.0f};  // Drawing, without swapping the buffers
+        bool hitch {false};
+    };
+
+    // Frame times in milliseconds
+    struct FrameStatisticsSummary {
+        float min {0.0f};
+        float avg {0.0f};
+        float p50 {0.0f};
+        float p95 {0.0f};
+        float p99 {0.0f};
+        float max {0.0f};
+        float avg_update {0.0f};
+        float avg_render {0.0f};
+        std::size_t hitches {0};
+        std::size_t frames {0};
+    };
+
+    // The latest frames are kept in a ring for rolling statistics, while all the frames since the start go into
+    // a histogram, which is less precise, but doesn't grow
+    class FrameStatistics {
+    public:
+        static constexpr std::size_t CAPACITY {1024};
+
+        // A frame longer than this many times the average of the window is a hitch
+        static constexpr float HITCH_FACTOR {2.0f};
+
+        void add_frame(float total, float update, float render);
+
+        // Over the latest frames, at most CAPACITY
+        FrameStatisticsSummary calculate(std::size_t last = CAPACITY) const;
+
+        // Over all the frames since the start
+        FrameStatisticsSummary calculate_total() const;
+
+        // The latest frame is at age 0
+        const FrameTime& get_frame(std::size_t age) const;
+        std::size_t get_frame_count() const { return count; }
+    private:
+        static constexpr float BUCKET_SIZE {0.1f};  // In milliseconds
+        static constexpr std::size_t BUCKETS {2000};  // The last one holds all the longer frames
+
+        std::array<FrameTime, CAPACITY> frames {};
+        std::size_t next {0};
+        std::size_t count {0};
+        double window_total {0.0};
+
+        std::array<std::uint32_t, BUCKETS> histogram {};
+        double total_time {0.0};
+        double total_update {0.0};
+        double total_render {0.0};
+        float total_min {0.0f};
+        float total_max {0.0f};
+        std::size_t total_hitches {0};
+        std::size_t total_frames {0};
+    };
+}
@@ -15,6 +15,8 @@ namespace bb {
         GL_COLOR_ATTACHMENT3
     };
 
+    unsigned int Framebuffer::default_framebuffer {0};
+
     static GLenum target(bool multisampled) {
         return multisampled ? GL_TEXTURE_2D_MULTISAMPLE : GL_TEXTURE_2D;
     }
@@ -199,7 +201,11 @@ namespace bb {
     }
 
     void Framebuffer::bind_default() {
-        glBindFramebuffer(GL_FRAMEBUFFER, 0);
+        glBindFramebuffer(GL_FRAMEBUFFER, default_framebuffer);
+    }
+
+    void Framebuffer::set_default(const Framebuffer* framebuffer) {
+        default_framebuffer = framebuffer != nullptr ? framebuffer->framebuffer : 0;
     }
 
     unsigned int Framebuffer::get_color_attachment(int attachment_index) const {
@@ -214,7 +220,7 @@ namespace bb {
 
     void Framebuffer::resize(int width, int height) {
         if (width < 1 || height < 1 || width > 8192 || height > 8192) {
-            log_message("Attempted to resize framebuffer to [%d, %d]\n", width, height);
+            BB_LOG_WARNING(Renderer, "Attempted to resize framebuffer to [%d, %d]\n", width, height);
             return;
         }
 
@@ -475,8 +481,8 @@ namespace bb {
         const GLenum status {glCheckFramebufferStatus(GL_FRAMEBUFFER)};
 
         if (status != GL_FRAMEBUFFER_COMPLETE) {
-            log_message("GL framebuffer %d is incomplete\n", framebuffer);
-            log_message("Status: %s\n", print_framebuffer_status_message(status));
+            BB_LOG_ERROR(Renderer, "GL framebuffer %d is incomplete\n", framebuffer);
+            BB_LOG_ERROR(Renderer, "Status: %s\n", print_framebuffer_status_message(status));
             throw OtherError;
         }
 
@@ -59,6 +59,9 @@ namespace bb {
         void bind() const;
         static void bind_default();
 
+        // What is bound as default instead of the screen, if not null; the window uses it when it's headless
+        static void set_default(const Framebuffer* framebuffer);
+
         unsigned int get_color_attachment(int attachment_index) const;
         unsigned int get_depth_attachment() const;
         const FramebufferSpecification& get_specification() const { return specification; }
@@ -85,5 +88,7 @@ namespace bb {
         // These can be texture or renderbuffer handles
         std::vector<unsigned int> color_attachments;
         unsigned int depth_attachment {0};
+
+        static unsigned int default_framebuffer;
     };
 }
@@ -0,0 +1,117 @@
+#include <glad/glad.h>
+
+#include "engine/gpu_timer.hpp"
+#include "engine/profiler.hpp"
+
+namespace bb {
+    GpuTimer::~GpuTimer() {
+        for (Frame& frame : frames) {
+            if (!frame.queries.empty()) {
+                glDeleteQueries(static_cast<GLsizei>(frame.queries.size()), frame.queries.data());
+            }
+        }
+    }
+
+    void GpuTimer::begin_frame() {
+        // Always time the frames of a profiling capture
+        active = enabled || Profiler::is_capturing();
+
+        if (!active) {
+            return;
+        }
+
+        Frame& frame {frames[current_frame]};
+
+        // This frame was issued FRAMES frames ago
+        if (frame.pending) {
+            read_results(frame);
+        }
+
+        frame.pass_count = 0;
+        frame.names.clear();
+        frame.cpu_durations.clear();
+
+        GLint64 gpu_time {0};
+        glGetInteger64v(GL_TIMESTAMP, &gpu_time);
+
+        frame.gpu_time = gpu_time;
+        frame.cpu_time = Profiler::get_time();
+    }
+
+    void GpuTimer::end_frame() {
+        if (!active) {
+            return;
+        }
+
+        Frame& frame {frames[current_frame]};
+        frame.pending = frame.pass_count > 0;
+
+        current_frame = (current_frame + 1) % FRAMES;
+    }
+
+    void GpuTimer::begin_pass(const char* name) {
+        if (!active) {
+            return;
+        }
+
+        Frame& frame {frames[current_frame]};
+
+        if (frame.queries.size() < (frame.pass_count + 1) * 2) {
+            unsigned int queries[2] {};
+            glGenQueries(2, queries);
+
+            frame.queries.push_back(queries[0]);
+            frame.queries.push_back(queries[1]);
+        }
+
+        frame.names.push_back(name);
+
+        glQueryCounter(frame.queries[frame.pass_count * 2], GL_TIMESTAMP);
+
+        pass_begin = Profiler::get_time();
+    }
+
+    void GpuTimer::end_pass() {
+        if (!active) {
+            return;
+        }
+
+        Frame& frame {frames[current_frame]};
+
+        glQueryCounter(frame.queries[frame.pass_count * 2 + 1], GL_TIMESTAMP);
+
+        frame.cpu_durations.push_back(Profiler::get_time() - pass_begin);
+        frame.pass_count++;
+    }
+
+    void GpuTimer::read_results(Frame& frame) {
+        frame.pending = false;
+
+        // Results come in order, so if the last one is available, all are; if it's not, drop the frame instead of waiting
+        GLint available {0};
+        glGetQueryObjectiv(frame.queries[frame.pass_count * 2 - 1], GL_QUERY_RESULT_AVAILABLE, &available);
+
+        if (!available) {
+            return;
+        }
+
+        pass_times.clear();
+
+        for (std::size_t i {0}; i < frame.pass_count; i++) {
+            GLuint64 begin {0};
+            GLuint64 end {0};
+            glGetQueryObjectui64v(frame.queries[i * 2], GL_QUERY_RESULT, &begin);
+            glGetQueryObjectui64v(frame.queries[i * 2 + 1], GL_QUERY_RESULT, &end);
+
+            GpuPassTime pass_time;
+            pass_time.name = frame.names[i];
+            pass_time.begin = frame.cpu_time + static_cast<std::uint64_t>(static_cast<std::int64_t>(begin) - frame.gpu_time);
+            pass_time.end = frame.cpu_time + static_cast<std::uint64_t>(static_cast<std::int64_t>(end) - frame.gpu_time);
+            pass_time.cpu_duration = frame.cpu_durations[i];
+
+            pass_times.push_back(pass_time);
+
+            Profiler::record_gpu(pass_time.name, pass_time.begin, pass_time.end);
+        }
+    }
+}
@@ -0,0 +1,65 @@
+#pragma once
+
+#include <vector>
+#include <cstddef>
+#include <cstdint>
+
+namespace bb {
+    struct GpuPassTime {
+        const char* name {nullptr};
+        std::uint64_t begin {0};  // Nanoseconds, in the time of the profiler
+        std::uint64_t end {0};
+        std::uint64_t cpu_duration {0};  // Nanoseconds the CPU spent issuing the pass
+    };
+
+    // Times render passes on the GPU with timestamp queries. The results are read a few frames later, when they
+    // are surely available, so that the CPU never waits for the GPU.
+    class GpuTimer {
+    public:
+        GpuTimer() = default;
+        ~GpuTimer();
+
+        GpuTimer(const GpuTimer&) = delete;
+        GpuTimer& operator=(const GpuTimer&) = delete;
+        GpuTimer(GpuTimer&&) = delete;
+        GpuTimer& operator=(GpuTimer&&) = delete;
+
+        void begin_frame();
+        void end_frame();
+
+        // Passes must not overlap
+        void begin_pass(const char* name);
+        void end_pass();
+
+        void set_enabled(bool enabled) { this->enabled = enabled; }
+        bool is_enabled() const { return enabled; }
+
+        // Of the latest frame that finished on the GPU
+        const std::vector<GpuPassTime>& get_pass_times() const { return pass_times; }
+    private:
+        struct Frame {
+            std::vector<unsigned int> queries;  // Pairs of begin and end timestamps
+            std::vector<const char*> names;
+            std::vector<std::uint64_t> cpu_durations;
+            std::size_t pass_count {0};
+
+            // Taken at the same time, to place the GPU timestamps in the time of the profiler
+            std::int64_t gpu_time {0};
+            std::uint64_t cpu_time {0};
+
+            bool pending {false};
+        };
+
+        void read_results(Frame& frame);
+
+        static constexpr std::size_t FRAMES {3};
+
+        Frame frames[FRAMES];
+        std::size_t current_frame {0};
+        bool active {false};  // In the current frame
+        std::uint64_t pass_begin {0};  // On the CPU
+        bool enabled {false};
+
+        std::vector<GpuPassTime> pass_times;
+    };
+}
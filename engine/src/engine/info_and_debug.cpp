@@ -19,12 +19,12 @@ namespace bb {
     ) {
         switch (severity) {
             case GL_DEBUG_SEVERITY_HIGH:
-                log_message("(%d) OpenGL: %s\n", id, message);
+                BB_LOG_ERROR(Renderer, "(%d) OpenGL: %s\n", id, message);
 
                 break;
             case GL_DEBUG_SEVERITY_MEDIUM:
             case GL_DEBUG_SEVERITY_LOW:
-                log_message("(%d) OpenGL: %s\n", id, message);
+                BB_LOG_WARNING(Renderer, "(%d) OpenGL: %s\n", id, message);
 
                 break;
             case GL_DEBUG_SEVERITY_NOTIFICATION:
@@ -0,0 +1,196 @@
+#include <string>
+#include <vector>
+#include <fstream>
+#include <cstdint>
+#include <cstring>
+#include <utility>
+#include <iterator>
+#include <cassert>
+
+#include "engine/input_recording.hpp"
+#include "engine/panic.hpp"
+#include "engine/logging.hpp"
+
+/*
+    The file is a header followed by the frames:
+
+    char[4]  magic
+    uint32   version
+    uint32   seed
+    uint32   frame count
+
+    float32  dt
+    uint16   event count
+        uint8    type
+        int32[]  values, as many as the type has
+
+    Everything is written in the byte order of the machine.
+*/
+
+namespace bb {
+    static constexpr char MAGIC[4] {'B', 'B', 'I', 'R'};
+    static constexpr std::uint32_t VERSION {1u};
+
+    static constexpr std::size_t VALUE_COUNT[] {
+        2,  // KeyPressed: key, repeat
+        1,  // KeyReleased: key
+        5,  // MouseMoved: buttons, x, y, xrel, yrel
+        3,  // MouseButtonPressed: button, x, y
+        3,  // MouseButtonReleased: button, x, y
+        1  // MouseWheelScrolled: scroll
+    };
+
+    // A frame without events
+    static constexpr std::uint64_t MIN_FRAME_SIZE {sizeof(float) + sizeof(std::uint16_t)};
+
+    template<typename T>
+    static void write(std::ofstream& stream, T value) {
+        stream.write(reinterpret_cast<const char*>(&value), sizeof(T));
+    }
+
+    template<typename T>
+    static T read(std::ifstream& stream) {
+        T value {};
+        stream.read(reinterpret_cast<char*>(&value), sizeof(T));
+
+        return value;
+    }
+
+    void InputRecording::load(const std::string& file_path) {
+        std::ifstream stream {file_path, std::ios::binary};
+
+        if (!stream.is_open()) {
+            BB_LOG_ERROR(Input, "Could not open file `%s` for reading\n", file_path.c_str());
+            throw ResourceLoadingError;
+        }
+
+        char magic[4] {};
+        stream.read(magic, sizeof(magic));
+
+        if (std::memcmp(magic, MAGIC, sizeof(MAGIC)) != 0 || read<std::uint32_t>(stream) != VERSION) {
+            BB_LOG_ERROR(Input, "File `%s` is not an input recording\n", file_path.c_str());
+            throw ResourceLoadingError;
+        }
+
+        seed = read<std::uint32_t>(stream);
+
+        const std::uint32_t frame_count {read<std::uint32_t>(stream)};
+
+        // The count is not to be trusted before checking that the frames can be in the rest of the file
+        const std::streamoff begin {stream.tellg()};
+        stream.seekg(0, std::ios::end);
+        const std::streamoff end {stream.tellg()};
+        stream.seekg(begin);
+
+        const std::uint64_t size_left {static_cast<std::uint64_t>(end - begin)};
+
+        if (!stream || static_cast<std::uint64_t>(frame_count) * MIN_FRAME_SIZE > size_left) {
+            BB_LOG_ERROR(Input, "Input recording `%s` is truncated\n", file_path.c_str());
+            throw ResourceLoadingError;
+        }
+
+        frames.clear();
+        frames.reserve(frame_count);
+        current_frame = 0;
+
+        for (std::uint32_t i {0}; i < frame_count; i++) {
+            RecordedFrame frame;
+            frame.dt = read<float>(stream);
+
+            const std::uint16_t event_count {read<std::uint16_t>(stream)};
+
+            if (!stream) {
+                BB_LOG_ERROR(Input, "Input recording `%s` is truncated\n", file_path.c_str());
+                throw ResourceLoadingError;
+            }
+
+            for (std::uint16_t j {0}; j < event_count; j++) {
+                const std::uint8_t type {read<std::uint8_t>(stream)};
+
+                if (!stream) {
+                    BB_LOG_ERROR(Input, "Input recording `%s` is truncated\n", file_path.c_str());
+                    throw ResourceLoadingError;
+                }
+
+                if (type >= std::size(VALUE_COUNT)) {
+                    BB_LOG_ERROR(Input, "Input recording `%s` is corrupted\n", file_path.c_str());
+                    throw ResourceLoadingError;
+                }
+
+                RecordedEvent event;
+                event.type = static_cast<RecordedEvent::Type>(type);
+
+                for (std::size_t k {0}; k < VALUE_COUNT[type]; k++) {
+                    event.values[k] = read<std::int32_t>(stream);
+                }
+
+                frame.events.push_back(event);
+            }
+
+            if (!stream) {
+                BB_LOG_ERROR(Input, "Input recording `%s` is truncated\n", file_path.c_str());
+                throw ResourceLoadingError;
+            }
+
+            frames.push_back(std::move(frame));
+        }
+
+        BB_LOG_INFO(Input, "Loaded input recording `%s` with %u frames\n", file_path.c_str(), frame_count);
+    }
+
+    void InputRecording::save(const std::string& file_path) const {
+        std::ofstream stream {file_path, std::ios::binary | std::ios::trunc};
+
+        if (!stream.is_open()) {
+            BB_LOG_ERROR(Input, "Could not open file `%s` for writing\n", file_path.c_str());
+            throw OtherError;
+        }
+
+        stream.write(MAGIC, sizeof(MAGIC));
+        write<std::uint32_t>(stream, VERSION);
+        write<std::uint32_t>(stream, seed);
+        write<std::uint32_t>(stream, static_cast<std::uint32_t>(frames.size()));
+
+        for (const RecordedFrame& frame : frames) {
+            write<float>(stream, frame.dt);
+            write<std::uint16_t>(stream, static_cast<std::uint16_t>(frame.events.size()));
+
+            for (const RecordedEvent& event : frame.events) {
+                const auto type {static_cast<std::uint8_t>(event.type)};
+                write<std::uint8_t>(stream, type);
+
+                for (std::size_t k {0}; k < VALUE_COUNT[type]; k++) {
+                    write<std::int32_t>(stream, event.values[k]);
+                }
+            }
+        }
+
+        BB_LOG_INFO(Input, "Saved input recording `%s` with %zu frames\n", file_path.c_str(), frames.size());
+    }
+
+    void InputRecording::begin_frame(float dt) {
+        RecordedFrame frame;
+        frame.dt = dt;
+
+        frames.push_back(std::move(frame));
+    }
+
+    void InputRecording::add_event(const RecordedEvent& event) {
+        assert(!frames.empty());
+
+        // Not likely at all, but the count must fit in the file
+        if (frames.back().events.size() == UINT16_MAX) {
+            return;
+        }
+
+        frames.back().events.push_back(event);
+    }
+
+    const RecordedFrame* InputRecording::next_frame() {
+        if (current_frame == frames.size()) {
+            return nullptr;
+        }
+
+        return &frames[current_frame++];
+    }
+}
@@ -0,0 +1,50 @@
+#pragma once
+
+#include <string>
+#include <vector>
+#include <cstddef>
+
+namespace bb {
+    // One input event, as it came from the window
+    struct RecordedEvent {
+        enum class Type : unsigned char {
+            KeyPressed,
+            KeyReleased,
+            MouseMoved,
+            MouseButtonPressed,
+            MouseButtonReleased,
+            MouseWheelScrolled
+        } type {};
+
+        int values[5] {};  // The fields of the event, in order
+    };
+
+    struct RecordedFrame {
+        float dt {};
+        std::vector<RecordedEvent> events;
+    };
+
+    // Everything that makes a session unique: the seed, the delta time and the input events of every frame
+    class InputRecording {
+    public:
+        InputRecording() = default;
+        InputRecording(unsigned int seed)
+            : seed(seed) {}
+
+        void load(const std::string& file_path);
+        void save(const std::string& file_path) const;
+
+        void begin_frame(float dt);
+        void add_event(const RecordedEvent& event);
+
+        // Return nullptr when there are no frames left
+        const RecordedFrame* next_frame();
+
+        unsigned int get_seed() const { return seed; }
+        std::size_t get_frame_count() const { return frames.size(); }
+    private:
+        unsigned int seed {0u};
+        std::vector<RecordedFrame> frames;
+        std::size_t current_frame {0};
+    };
+}
@@ -1,15 +1,268 @@
+#include <atomic>
+#include <thread>
+#include <mutex>
+#include <chrono>
 #include <cstdio>
 #include <cstdarg>
+#include <cstdint>
+#include <cstring>
 
 #include "engine/logging.hpp"
 
 namespace bb {
-    void log_message(const char* format, ...) {
-        va_list list;
+    // Must be a power of two
+    static constexpr std::size_t CAPACITY {1024};
+
+    // Longer messages are truncated
+    static constexpr std::size_t MAX_MESSAGE_SIZE {512};
+
+    struct LogRecord {
+        // Tells if the record is free for the producers or ready for the writer
+        std::atomic<std::size_t> sequence {0};
+
+        LogLevel level {};
+        LogCategory category {};
+        double time {0.0};
+        char message[MAX_MESSAGE_SIZE] {};
+    };
+
+    // Bounded queue with many producers and one consumer, after Dmitry Vyukov's one
+    // https://www.1024cores.net/home/lock-free-algorithms/queues/bounded-mpmc-queue
+    class Logger {
+    public:
+        Logger();
+        ~Logger();
+
+        Logger(const Logger&) = delete;
+        Logger& operator=(const Logger&) = delete;
+        Logger(Logger&&) = delete;
+        Logger& operator=(Logger&&) = delete;
+
+        void push(LogLevel level, LogCategory category, const char* format, std::va_list list);
+        void set_file(const std::string& file_path);
+        void flush();
+
+        std::size_t get_dropped() const { return dropped.load(std::memory_order_relaxed); }
+    private:
+        void run();
+        bool pop_and_write();
+
+        LogRecord records[CAPACITY];
+
+        alignas(64) std::atomic<std::size_t> enqueue_position {0};
+        alignas(64) std::atomic<std::size_t> dequeue_position {0};  // Written only by the writer
+
+        std::atomic<std::size_t> dropped {0};
+        std::size_t reported_dropped {0};
+
+        std::chrono::steady_clock::time_point start;
+
+        std::mutex file_mutex;
+        std::FILE* file {stdout};
+
+        std::atomic<bool> running {true};
+        std::thread thread;
+    };
+
+    static const char* level_name(LogLevel level) {
+        switch (level) {
+            case LogLevel::Debug:
+                return "debug";
+            case LogLevel::Info:
+                return "info";
+            case LogLevel::Warning:
+                return "warning";
+            case LogLevel::Error:
+                return "error";
+        }
+
+        return "";
+    }
+
+    static const char* category_name(LogCategory category) {
+        switch (category) {
+            case LogCategory::General:
+                return "general";
+            case LogCategory::Application:
+                return "application";
+            case LogCategory::Window:
+                return "window";
+            case LogCategory::Renderer:
+                return "renderer";
+            case LogCategory::Resources:
+                return "resources";
+            case LogCategory::Audio:
+                return "audio";
+            case LogCategory::Input:
+                return "input";
+            case LogCategory::Game:
+                return "game";
+        }
+
+        return "";
+    }
+
+    Logger::Logger()
+        : start(std::chrono::steady_clock::now()) {
+        for (std::size_t i {0}; i < CAPACITY; i++) {
+            records[i].sequence.store(i, std::memory_order_relaxed);
+        }
+
+        thread = std::thread(&Logger::run, this);
+    }
+
+    Logger::~Logger() {
+        running.store(false);
+        thread.join();
+
+        if (file != stdout) {
+            std::fclose(file);
+        }
+    }
+
+    void Logger::push(LogLevel level, LogCategory category, const char* format, std::va_list list) {
+        std::size_t position {enqueue_position.load(std::memory_order_relaxed)};
+        LogRecord* record {nullptr};
+
+        while (true) {
+            record = &records[position & (CAPACITY - 1)];
+
+            const std::size_t sequence {record->sequence.load(std::memory_order_acquire)};
+            const std::intptr_t difference {static_cast<std::intptr_t>(sequence) - static_cast<std::intptr_t>(position)};
+
+            if (difference == 0) {
+                if (enqueue_position.compare_exchange_weak(position, position + 1, std::memory_order_relaxed)) {
+                    break;
+                }
+            } else if (difference < 0) {
+                // Full; the writer is behind
+                dropped.fetch_add(1, std::memory_order_relaxed);
+                return;
+            } else {
+                position = enqueue_position.load(std::memory_order_relaxed);
+            }
+        }
+
+        record->level = level;
+        record->category = category;
+        record->time = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+        // Only the arguments are formatted here, as they may not live long enough for the writer
+        const int size {std::vsnprintf(record->message, MAX_MESSAGE_SIZE, format, list)};
+
+        if (size >= static_cast<int>(MAX_MESSAGE_SIZE)) {
+            std::memcpy(record->message + MAX_MESSAGE_SIZE - 5, "...\n", 5);
+        }
+
+        record->sequence.store(position + 1, std::memory_order_release);
+    }
+
+    void Logger::set_file(const std::string& file_path) {
+        std::FILE* new_file {stdout};
+
+        if (!file_path.empty()) {
+            new_file = std::fopen(file_path.c_str(), "w");
+
+            if (new_file == nullptr) {
+                std::fprintf(stderr, "Could not open log file `%s` for writing\n", file_path.c_str());
+                return;
+            }
+        }
+
+        std::lock_guard<std::mutex> lock {file_mutex};
+
+        if (file != stdout) {
+            std::fclose(file);
+        }
+
+        file = new_file;
+    }
+
+    void Logger::flush() {
+        const std::size_t position {enqueue_position.load()};
+
+        while (dequeue_position.load(std::memory_order_acquire) < position) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+    }
+
+    void Logger::run() {
+        while (true) {
+            // Check before writing, to not miss anything pushed just before stopping
+            const bool stopping {!running.load()};
+
+            bool written {false};
+
+            while (pop_and_write()) {
+                written = true;
+            }
+
+            if (written) {
+                std::lock_guard<std::mutex> lock {file_mutex};
+                std::fflush(file);
+            }
+
+            if (stopping) {
+                break;
+            }
+
+            if (!written) {
+                std::this_thread::sleep_for(std::chrono::milliseconds(2));
+            }
+        }
+    }
+
+    bool Logger::pop_and_write() {
+        const std::size_t position {dequeue_position.load(std::memory_order_relaxed)};
+        LogRecord& record {records[position & (CAPACITY - 1)]};
+
+        if (record.sequence.load(std::memory_order_acquire) != position + 1) {
+            return false;
+        }
+
+        std::lock_guard<std::mutex> lock {file_mutex};
+
+        const std::size_t current_dropped {dropped.load(std::memory_order_relaxed)};
+
+        if (current_dropped != reported_dropped) {
+            std::fprintf(file, "(%zu log messages dropped)\n", current_dropped - reported_dropped);
+            reported_dropped = current_dropped;
+        }
+
+        std::fprintf(file, "[%10.4f] [%s] [%s] %s", record.time, level_name(record.level), category_name(record.category), record.message);
+
+        // Give the record back to the producers
+        record.sequence.store(position + CAPACITY, std::memory_order_release);
+        dequeue_position.store(position + 1, std::memory_order_release);
+
+        return true;
+    }
+
+    static Logger& get_logger() {
+        // Started on first use, stopped after main returns, writing what's left
+        static Logger logger;
+
+        return logger;
+    }
+
+    void log_message(LogLevel level, LogCategory category, const char* format, ...) {
+        std::va_list list;
         va_start(list, format);
 
-        std::vprintf(format, list);
+        get_logger().push(level, category, format, list);
 
         va_end(list);
     }
+
+    void set_log_file(const std::string& file_path) {
+        get_logger().set_file(file_path);
+    }
+
+    void flush_log() {
+        get_logger().flush();
+    }
+
+    std::size_t get_dropped_log_messages() {
+        return get_logger().get_dropped();
+    }
 }
@@ -1,7 +1,83 @@
 #pragma once
 
 #include <string>
+#include <cstddef>
+
+/*
+    Messages are put into a ring buffer and written by a background thread, so logging never blocks and never waits
+    for the terminal. If the buffer is full, messages are dropped and counted instead.
+
+    Use the macros, which compile away below BB_LOG_LEVEL. Their arguments are then still checked, but not evaluated,
+    so that the arguments used only for logging don't go unused.
+*/
+
+#define BB_LOG_LEVEL_DEBUG 0
+#define BB_LOG_LEVEL_INFO 1
+#define BB_LOG_LEVEL_WARNING 2
+#define BB_LOG_LEVEL_ERROR 3
+#define BB_LOG_LEVEL_NONE 4
+
+#ifndef BB_LOG_LEVEL
+    #ifdef BB_RELEASE
+        #define BB_LOG_LEVEL BB_LOG_LEVEL_INFO
+    #else
+        #define BB_LOG_LEVEL BB_LOG_LEVEL_DEBUG
+    #endif
+#endif
+
+#if BB_LOG_LEVEL <= BB_LOG_LEVEL_DEBUG
+    #define BB_LOG_DEBUG(category, ...) ::bb::log_message(::bb::LogLevel::Debug, ::bb::LogCategory::category, __VA_ARGS__)
+#else
+    #define BB_LOG_DEBUG(category, ...) ((void) sizeof((::bb::log_message(::bb::LogLevel::Debug, ::bb::LogCategory::category, __VA_ARGS__), 0)))
+#endif
+
+#if BB_LOG_LEVEL <= BB_LOG_LEVEL_INFO
+    #define BB_LOG_INFO(category, ...) ::bb::log_message(::bb::LogLevel::Info, ::bb::LogCategory::category, __VA_ARGS__)
+#else
+    #define BB_LOG_INFO(category, ...) ((void) sizeof((::bb::log_message(::bb::LogLevel::Info, ::bb::LogCategory::category, __VA_ARGS__), 0)))
+#endif
+
+#if BB_LOG_LEVEL <= BB_LOG_LEVEL_WARNING
+    #define BB_LOG_WARNING(category, ...) ::bb::log_message(::bb::LogLevel::Warning, ::bb::LogCategory::category, __VA_ARGS__)
+#else
+    #define BB_LOG_WARNING(category, ...) ((void) sizeof((::bb::log_message(::bb::LogLevel::Warning, ::bb::LogCategory::category, __VA_ARGS__), 0)))
+#endif
+
+#if BB_LOG_LEVEL <= BB_LOG_LEVEL_ERROR
+    #define BB_LOG_ERROR(category, ...) ::bb::log_message(::bb::LogLevel::Error, ::bb::LogCategory::category, __VA_ARGS__)
+#else
+    #define BB_LOG_ERROR(category, ...) ((void) sizeof((::bb::log_message(::bb::LogLevel::Error, ::bb::LogCategory::category, __VA_ARGS__), 0)))
+#endif
 
 namespace bb {
-    void log_message(const char* format, ...);
+    enum class LogLevel {
+        Debug,
+        Info,
+        Warning,
+        Error
+    };
+
+    enum class LogCategory {
+        General,
+        Application,
+        Window,
+        Renderer,
+        Resources,
+        Audio,
+        Input,
+        Game
+    };
+
+#if defined(__GNUC__) || defined(__clang__)
+    __attribute__((format(printf, 3, 4)))
+#endif
+    void log_message(LogLevel level, LogCategory category, const char* format, ...);
+
+    // Write to this file instead of the standard output; empty for the standard output
+    void set_log_file(const std::string& file_path);
+
+    // Wait until everything logged so far is written
+    void flush_log();
+
+    std::size_t get_dropped_log_messages();
 }
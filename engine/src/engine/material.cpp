@@ -128,7 +128,10 @@ namespace bb {
 
     void MaterialInstance::bind_and_upload() const {
         shader->bind();
+        upload();
+    }
 
+    void MaterialInstance::upload() const {
         for (const auto& [name, element] : offsets) {
             switch (element.type) {
                 case Element::Type::Mat4: {
@@ -71,6 +71,7 @@ namespace bb {
         MaterialInstance& operator=(MaterialInstance&&) = delete;
 
         void bind_and_upload() const;
+        void upload() const;  // The shader must be bound already
 
         void set_mat4(Key name, const glm::mat4& matrix);
         void set_int(Key name, int integer);
@@ -110,5 +111,7 @@ namespace bb {
         std::size_t size {0};
 
         std::unordered_map<Key, Element, KeyHash> offsets;
+
+        friend class RenderCapture;
     };
 }
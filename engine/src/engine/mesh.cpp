@@ -150,8 +150,8 @@ namespace bb {
         const aiScene* scene {importer.ReadFile(file_path, flags)};
 
         if (scene == nullptr) {
-            log_message("Could not load model data `%s`\n", file_path.c_str());
-            log_message("Assimp: %s\n", importer.GetErrorString());
+            BB_LOG_ERROR(Resources, "Could not load model data `%s`\n", file_path.c_str());
+            BB_LOG_ERROR(Resources, "Assimp: %s\n", importer.GetErrorString());
             throw ResourceLoadingError;
         }
 
@@ -159,7 +159,7 @@ namespace bb {
         const aiMesh* mesh {find_mesh(root_node, object_name, scene)};
 
         if (mesh == nullptr) {
-            log_message("Model file `%s` does not contain `%s` mesh\n", file_path.c_str(), object_name.c_str());
+            BB_LOG_ERROR(Resources, "Model file `%s` does not contain `%s` mesh\n", file_path.c_str(), object_name.c_str());
             throw ResourceLoadingError;
         }
 
@@ -1,6 +1,7 @@
 #include <glad/glad.h>
 
 #include "engine/opengl.hpp"
+#include "engine/frame_counters.hpp"
 
 namespace bb {
     void OpenGl::initialize_default() {
@@ -54,18 +55,26 @@ namespace bb {
 
     void OpenGl::draw_arrays(int count) {
         glDrawArrays(GL_TRIANGLES, 0, count);
+
+        FrameCounters::count_draw_call();
     }
 
     void OpenGl::draw_arrays_lines(int count) {
         glDrawArrays(GL_LINES, 0, count);
+
+        FrameCounters::count_draw_call();
     }
 
     void OpenGl::draw_elements(int count) {
         glDrawElements(GL_TRIANGLES, count, GL_UNSIGNED_INT, nullptr);
+
+        FrameCounters::count_draw_call();
     }
 
-    void OpenGl::draw_elements_instanced(int count, int instance_count) {
-        glDrawElementsInstanced(GL_TRIANGLES, count, GL_UNSIGNED_INT, nullptr, instance_count);
+    void OpenGl::draw_elements_instanced(int count, int instance_count, unsigned int base_instance) {
+        glDrawElementsInstancedBaseInstance(GL_TRIANGLES, count, GL_UNSIGNED_INT, nullptr, instance_count, base_instance);
+
+        FrameCounters::count_draw_call();
     }
 
     void OpenGl::disable_depth_test() {
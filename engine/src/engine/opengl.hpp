@@ -34,7 +34,7 @@ namespace bb {
         static void draw_arrays(int count);
         static void draw_arrays_lines(int count);
         static void draw_elements(int count);
-        static void draw_elements_instanced(int count, int instance_count);
+        static void draw_elements_instanced(int count, int instance_count, unsigned int base_instance = 0);
 
         static void disable_depth_test();
         static void enable_depth_test();
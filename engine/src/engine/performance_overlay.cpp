@@ -0,0 +1,152 @@
+#include <algorithm>
+#include <cstdio>
+#include <cstddef>
+#include <cstdint>
+
+#include <glm/glm.hpp>
+
+#include "engine/performance_overlay.hpp"
+#include "engine/renderer.hpp"
+#include "engine/renderable.hpp"
+#include "engine/font.hpp"
+#include "engine/frame_statistics.hpp"
+#include "engine/frame_counters.hpp"
+#include "engine/gpu_timer.hpp"
+#include "engine/profiler.hpp"
+
+namespace bb {
+    static constexpr float MARGIN {8.0f};
+    static constexpr float TEXT_SCALE {0.3f};
+
+    // One pixel per frame, up to GRAPH_MAX_TIME milliseconds
+    static constexpr std::size_t GRAPH_FRAMES {300};
+    static constexpr float GRAPH_HEIGHT {100.0f};
+    static constexpr float GRAPH_MAX_TIME {50.0f};
+
+    // Statistics over a few seconds, to be readable
+    static constexpr std::size_t STATISTICS_FRAMES {300};
+
+    static const glm::vec3 TEXT_COLOR {0.9f, 0.9f, 0.9f};
+    static const glm::vec3 GOOD_COLOR {0.2f, 0.8f, 0.2f};
+    static const glm::vec3 SLOW_COLOR {0.9f, 0.8f, 0.1f};
+    static const glm::vec3 HITCH_COLOR {0.9f, 0.2f, 0.1f};
+    static const glm::vec3 REFERENCE_COLOR {0.4f, 0.4f, 0.4f};
+
+    static constexpr float TARGET_60_HZ {1000.0f / 60.0f};
+    static constexpr float TARGET_30_HZ {1000.0f / 30.0f};
+
+    static float bytes_to_kibibytes(std::uint64_t bytes) {
+        return static_cast<float>(static_cast<double>(bytes) / 1024.0);
+    }
+
+    static glm::vec3 frame_color(const FrameTime& frame) {
+        if (frame.hitch) {
+            return HITCH_COLOR;
+        }
+
+        return frame.total > TARGET_60_HZ ? SLOW_COLOR : GOOD_COLOR;
+    }
+
+    void PerformanceOverlay::draw(
+        Renderer& renderer,
+        const FrameStatistics& frame_statistics,
+        const FrameCounts& counts,
+        int width,
+        int height
+    ) {
+        if (font == nullptr) {
+            return;
+        }
+
+        // Lines of text go from the top left corner downwards, with the graph below them
+        const float line_height {static_cast<float>(font->get_string_size("0", TEXT_SCALE).second) * 1.4f};
+        float y {static_cast<float>(height) - MARGIN};
+
+        char line[128] {};
+
+        const auto add_line {[&]() {
+            y -= line_height;
+
+            // The text keeps its string from the previous frames, so that it doesn't allocate every frame
+            text.font = font;
+            text.string = line;
+            text.position = glm::vec2(MARGIN, y);
+            text.color = TEXT_COLOR;
+            text.scale = TEXT_SCALE;
+            text.shadows = true;
+
+            renderer.overlay_add_text(text);
+        }};
+
+        const FrameStatisticsSummary summary {frame_statistics.calculate(STATISTICS_FRAMES)};
+
+        std::snprintf(
+            line, sizeof(line), "frame avg %.2f min %.2f max %.2f ms, %zu hitches",
+            summary.avg, summary.min, summary.max, summary.hitches
+        );
+        add_line();
+
+        std::snprintf(line, sizeof(line), "p50 %.2f p95 %.2f p99 %.2f ms", summary.p50, summary.p95, summary.p99);
+        add_line();
+
+        std::snprintf(line, sizeof(line), "update %.2f render %.2f ms", summary.avg_update, summary.avg_render);
+        add_line();
+
+        std::snprintf(
+            line, sizeof(line), "%llu draw calls, %llu binds, %.1f KiB uploaded",
+            static_cast<unsigned long long>(counts.draw_calls),
+            static_cast<unsigned long long>(counts.binds),
+            bytes_to_kibibytes(counts.uploaded_bytes)
+        );
+        add_line();
+
+        std::snprintf(
+            line, sizeof(line), "%llu allocations, %.1f KiB",
+            static_cast<unsigned long long>(counts.allocations), bytes_to_kibibytes(counts.allocated_bytes)
+        );
+        add_line();
+
+        for (const GpuPassTime& pass_time : renderer.get_gpu_pass_times()) {
+            std::snprintf(
+                line, sizeof(line), "%-12s cpu %.3f gpu %.3f ms",
+                pass_time.name,
+                nanoseconds_to_milliseconds(pass_time.cpu_duration),
+                nanoseconds_to_milliseconds(pass_time.end - pass_time.begin)
+            );
+            add_line();
+        }
+
+        // The newest frame is on the right
+        const float graph_bottom {y - MARGIN - GRAPH_HEIGHT};
+        const float graph_right {std::min(MARGIN + static_cast<float>(GRAPH_FRAMES), static_cast<float>(width) - MARGIN)};
+        const auto graph_frames {std::min(frame_statistics.get_frame_count(), GRAPH_FRAMES)};
+
+        const auto to_graph_y {[graph_bottom](float time) {
+            return graph_bottom + std::min(time / GRAPH_MAX_TIME, 1.0f) * GRAPH_HEIGHT;
+        }};
+
+        for (std::size_t i {0}; i < graph_frames; i++) {
+            const float x {graph_right - static_cast<float>(i)};
+
+            if (x < MARGIN) {
+                break;
+            }
+
+            const FrameTime& frame {frame_statistics.get_frame(i)};
+
+            renderer.overlay_add_line(
+                glm::vec2(x, graph_bottom),
+                glm::vec2(x, to_graph_y(frame.total)),
+                frame_color(frame)
+            );
+        }
+
+        for (const float time : {TARGET_60_HZ, TARGET_30_HZ}) {
+            renderer.overlay_add_line(
+                glm::vec2(MARGIN, to_graph_y(time)),
+                glm::vec2(graph_right, to_graph_y(time)),
+                REFERENCE_COLOR
+            );
+        }
+    }
+}
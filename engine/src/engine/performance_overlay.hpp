@@ -0,0 +1,34 @@
+#pragma once
+
+#include <memory>
+
+#include "engine/renderable.hpp"
+
+namespace bb {
+    class Renderer;
+    class FrameStatistics;
+    struct FrameCounts;
+
+    // Frame time graph, frame statistics, render pass timings and counters, drawn over the scene; it's part of
+    // release builds too, so that any machine can be diagnosed
+    class PerformanceOverlay {
+    public:
+        // Nothing is drawn without a font
+        void set_font(std::shared_ptr<Font> font) { this->font = font; }
+
+        void set_visible(bool visible) { this->visible = visible; }
+        bool is_visible() const { return visible; }
+
+        void draw(
+            Renderer& renderer,
+            const FrameStatistics& frame_statistics,
+            const FrameCounts& counts,
+            int width,
+            int height
+        );
+    private:
+        std::shared_ptr<Font> font;
+        Text text;  // Reused
+        bool visible {false};
+    };
+}
@@ -0,0 +1,201 @@
+#include <vector>
+#include <memory>
+#include <atomic>
+#include <mutex>
+#include <chrono>
+#include <fstream>
+#include <iomanip>
+#include <cstddef>
+
+#include "engine/profiler.hpp"
+
+namespace bb {
+    // Scopes that don't fit are lost
+    static constexpr std::size_t BUFFER_CAPACITY {1u << 16u};
+
+    struct ProfileEvent {
+        const char* name {nullptr};
+        std::uint64_t begin {0};
+        std::uint64_t end {0};
+    };
+
+    // Written only by its thread; the events up to count can be read by anyone
+    struct ThreadBuffer {
+        ProfileEvent events[BUFFER_CAPACITY] {};
+        std::atomic<std::size_t> count {0};
+        std::atomic<std::uint64_t> generation {0};  // Of the capture the events belong to
+        std::size_t thread_id {0};
+        bool free {false};
+    };
+
+    static const std::chrono::steady_clock::time_point start_time {std::chrono::steady_clock::now()};
+
+    static std::atomic<bool> capturing {false};
+    static std::atomic<std::uint64_t> capture_generation {0};
+    static std::uint64_t capture_begin {0};
+
+    // Buffers are registered once per thread and reused after the threads end
+    static std::mutex buffers_mutex;
+    static std::vector<std::unique_ptr<ThreadBuffer>> buffers;
+
+    // There are only a few GPU timings per frame, so these are simply locked
+    static std::vector<ProfileEvent> gpu_events;
+    static constexpr std::size_t GPU_THREAD_ID {1000};
+
+    static ThreadBuffer* acquire_buffer() {
+        std::lock_guard<std::mutex> lock {buffers_mutex};
+
+        for (const auto& buffer : buffers) {
+            if (buffer->free) {
+                buffer->free = false;
+                return buffer.get();
+            }
+        }
+
+        buffers.push_back(std::make_unique<ThreadBuffer>());
+        buffers.back()->thread_id = buffers.size() - 1;
+
+        return buffers.back().get();
+    }
+
+    static void release_buffer(ThreadBuffer* buffer) {
+        std::lock_guard<std::mutex> lock {buffers_mutex};
+
+        buffer->free = true;
+    }
+
+    struct ThreadBufferHolder {
+        ThreadBufferHolder()
+            : buffer(acquire_buffer()) {}
+
+        ~ThreadBufferHolder() {
+            release_buffer(buffer);
+        }
+
+        ThreadBuffer* buffer {nullptr};
+    };
+
+    static void write_escaped(std::ofstream& stream, const char* string) {
+        for (const char* c {string}; *c != '\0'; c++) {
+            if (*c == '"' || *c == '\\') {
+                stream << '\\';
+            }
+
+            stream << *c;
+        }
+    }
+
+    static void write_event(std::ofstream& stream, const ProfileEvent& event, std::size_t thread_id, std::uint64_t capture_begin, std::uint64_t capture_end) {
+        if (event.begin < capture_begin || event.end > capture_end) {
+            return;
+        }
+
+        // Chrome wants microseconds
+        stream << ",\n{\"name\":\"";
+        write_escaped(stream, event.name);
+        stream << "\",\"ph\":\"X\",\"pid\":0,\"tid\":" << thread_id;
+        stream << ",\"ts\":" << static_cast<double>(event.begin - capture_begin) / 1000.0;
+        stream << ",\"dur\":" << static_cast<double>(event.end - event.begin) / 1000.0 << '}';
+    }
+
+    void Profiler::begin_capture() {
+        std::lock_guard<std::mutex> lock {buffers_mutex};
+
+        // Threads clear their buffers themselves the next time they record
+        capture_generation.fetch_add(1);
+        gpu_events.clear();
+        capture_begin = get_time();
+        capturing.store(true);
+    }
+
+    bool Profiler::end_capture(const std::string& file_path) {
+        std::lock_guard<std::mutex> lock {buffers_mutex};
+
+        capturing.store(false);
+
+        const std::uint64_t generation {capture_generation.load()};
+        const std::uint64_t capture_end {get_time()};
+
+        std::ofstream stream {file_path, std::ios::trunc};
+
+        if (!stream.is_open()) {
+            return false;
+        }
+
+        // Microseconds with three decimals keep the nanoseconds, however long the capture is
+        stream << std::fixed << std::setprecision(3);
+
+        stream << "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[";
+        stream << "\n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":0,\"tid\":" << GPU_THREAD_ID << ",\"args\":{\"name\":\"GPU\"}}";
+
+        for (const auto& buffer : buffers) {
+            // Events of a previous capture are only cleared by their thread
+            if (buffer->generation.load(std::memory_order_acquire) != generation) {
+                continue;
+            }
+
+            const std::size_t count {buffer->count.load(std::memory_order_acquire)};
+
+            for (std::size_t i {0}; i < count; i++) {
+                const ProfileEvent& event {buffer->events[i]};
+
+                write_event(stream, event, buffer->thread_id, capture_begin, capture_end);
+            }
+        }
+
+        for (const ProfileEvent& event : gpu_events) {
+            write_event(stream, event, GPU_THREAD_ID, capture_begin, capture_end);
+        }
+
+        stream << "\n]}\n";
+
+        return static_cast<bool>(stream);
+    }
+
+    bool Profiler::is_capturing() {
+        return capturing.load(std::memory_order_relaxed);
+    }
+
+    std::uint64_t Profiler::get_time() {
+        const auto duration {std::chrono::steady_clock::now() - start_time};
+
+        return static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(duration).count());
+    }
+
+    void Profiler::record_gpu(const char* name, std::uint64_t begin, std::uint64_t end) {
+        if (!capturing.load(std::memory_order_relaxed)) {
+            return;
+        }
+
+        std::lock_guard<std::mutex> lock {buffers_mutex};
+
+        gpu_events.push_back(ProfileEvent {name, begin, end});
+    }
+
+    void Profiler::record(const char* name, std::uint64_t begin, std::uint64_t end) {
+        if (!capturing.load(std::memory_order_relaxed)) {
+            return;
+        }
+
+        thread_local ThreadBufferHolder holder;
+        ThreadBuffer* buffer {holder.buffer};
+
+        // Acquire, so that clearing the buffer happens after the previous capture was written
+        const std::uint64_t generation {capture_generation.load(std::memory_order_acquire)};
+        std::size_t count {buffer->count.load(std::memory_order_relaxed)};
+
+        if (buffer->generation.load(std::memory_order_relaxed) != generation) {
+            // Clear the buffer before it's marked as part of the current capture
+            buffer->count.store(0, std::memory_order_relaxed);
+            buffer->generation.store(generation, std::memory_order_release);
+            count = 0;
+        }
+
+        if (count == BUFFER_CAPACITY) {
+            return;
+        }
+
+        buffer->events[count] = ProfileEvent {name, begin, end};
+        buffer->count.store(count + 1, std::memory_order_release);
+    }
+}
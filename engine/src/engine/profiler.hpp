@@ -0,0 +1,67 @@
+#pragma once
+
+#include <string>
+#include <cstdint>
+
+/*
+    Scopes are timed and recorded into a buffer of the thread they run on, without any locking. A capture can be
+    written as a Chrome trace, to be opened in about:tracing or in Perfetto.
+
+    Profiling is compiled in only with BB_PROFILE; otherwise the macros do nothing.
+*/
+
+#define BB_INTERNAL_CONCATENATE_(a, b) a##b
+#define BB_INTERNAL_CONCATENATE(a, b) BB_INTERNAL_CONCATENATE_(a, b)
+
+#ifdef BB_PROFILE
+    // The name must live forever, so it's best to be a string literal
+    #define BB_PROFILE_SCOPE(name) const ::bb::ProfileScope BB_INTERNAL_CONCATENATE(profile_scope_, __LINE__) {name}
+    #define BB_PROFILE_FUNCTION() BB_PROFILE_SCOPE(__func__)
+#else
+    #define BB_PROFILE_SCOPE(name) ((void) 0)
+    #define BB_PROFILE_FUNCTION() ((void) 0)
+#endif
+
+namespace bb {
+    class Profiler {
+    public:
+        // Forget what was recorded and start recording
+        static void begin_capture();
+
+        // Stop recording and write the capture to a file, returning false if it couldn't be written
+        static bool end_capture(const std::string& file_path);
+
+        static bool is_capturing();
+
+        // Nanoseconds since the start of the program
+        static std::uint64_t get_time();
+
+        static void record(const char* name, std::uint64_t begin, std::uint64_t end);
+
+        // Timings of the GPU go on their own track
+        static void record_gpu(const char* name, std::uint64_t begin, std::uint64_t end);
+    };
+
+    // For the times of the profiler and of the GPU timer
+    inline float nanoseconds_to_milliseconds(std::uint64_t nanoseconds) {
+        return static_cast<float>(static_cast<double>(nanoseconds) / 1'000'000.0);
+    }
+
+    class ProfileScope {
+    public:
+        explicit ProfileScope(const char* name)
+            : name(name), begin(Profiler::get_time()) {}
+
+        ~ProfileScope() {
+            Profiler::record(name, begin, Profiler::get_time());
+        }
+
+        ProfileScope(const ProfileScope&) = delete;
+        ProfileScope& operator=(const ProfileScope&) = delete;
+        ProfileScope(ProfileScope&&) = delete;
+        ProfileScope& operator=(ProfileScope&&) = delete;
+    private:
+        const char* name {nullptr};
+        std::uint64_t begin {0};
+    };
+}
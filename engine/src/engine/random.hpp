@@ -0,0 +1,69 @@
+#pragma once
+
+#include <cstdint>
+
+namespace bb {
+    // Small and fast pseudo random number generator (xoshiro128**). Every user owns and seeds its own, so that
+    // runs are reproducible and generators on different threads don't share any state.
+    // It's header only and doesn't depend on the rest of the engine.
+    class Random {
+    public:
+        Random() {
+            seed(0u);
+        }
+
+        Random(std::uint64_t seed) {
+            this->seed(seed);
+        }
+
+        void seed(std::uint64_t seed) {
+            // Expand the seed with splitmix64, as the state must not be all zeros
+            for (std::uint32_t& value : state) {
+                seed += 0x9E3779B97F4A7C15u;
+
+                std::uint64_t z {seed};
+                z = (z ^ (z >> 30u)) * 0xBF58476D1CE4E5B9u;
+                z = (z ^ (z >> 27u)) * 0x94D049BB133111EBu;
+                z = z ^ (z >> 31u);
+
+                value = static_cast<std::uint32_t>(z >> 32u);
+            }
+        }
+
+        std::uint32_t next() {
+            const std::uint32_t result {rotate_left(state[1] * 5u, 7u) * 9u};
+            const std::uint32_t t {state[1] << 9u};
+
+            state[2] ^= state[0];
+            state[3] ^= state[1];
+            state[1] ^= state[2];
+            state[0] ^= state[3];
+
+            state[2] ^= t;
+            state[3] = rotate_left(state[3], 11u);
+
+            return result;
+        }
+
+        // In [0, 1)
+        float next_float() {
+            return static_cast<float>(next() >> 8u) * (1.0f / 16777216.0f);
+        }
+
+        // In [min, max)
+        float linear(float min, float max) {
+            return min + (max - min) * next_float();
+        }
+
+        // True with the given probability
+        bool chance(float probability) {
+            return next_float() < probability;
+        }
+    private:
+        static std::uint32_t rotate_left(std::uint32_t x, std::uint32_t k) {
+            return (x << k) | (x >> (32u - k));
+        }
+
+        std::uint32_t state[4] {};
+    };
+}
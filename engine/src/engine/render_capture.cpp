@@ -0,0 +1,1134 @@
+#include <string>
+#include <vector>
+#include <memory>
+#include <fstream>
+#include <algorithm>
+#include <array>
+#include <utility>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+#include <glad/glad.h>
+#include <glm/glm.hpp>
+
+#include "engine/render_capture.hpp"
+#include "engine/renderer.hpp"
+#include "engine/framebuffer.hpp"
+#include "engine/vertex_array.hpp"
+#include "engine/buffer.hpp"
+#include "engine/shader.hpp"
+#include "engine/material.hpp"
+#include "engine/texture.hpp"
+#include "engine/font.hpp"
+#include "engine/renderable.hpp"
+#include "engine/panic.hpp"
+#include "engine/logging.hpp"
+
+/*
+    The file is a header followed by the resources and by the scene list:
+
+    char[4]      magic
+    uint32       version
+    int32        width, height, samples
+    float32[16]  view, projection, projection view; float32[3] position; float32[16] projection 2D
+
+    uint32       shader count
+        string       vertex, fragment, includes paths
+    uint32       mesh count
+        uint32       vertex buffer count
+            uint32       element count
+                uint32       index; uint8 type; int32 size; uint8 per instance
+            int32        stride
+            bytes        data
+        bytes        indices
+    uint32       texture count
+        int32        width, height
+        uint8        format, min filter, mag filter, wrap s, wrap t
+        float32[4]   border color; int32 mipmap levels; float32 bias
+        bytes        pixels
+    uint32       material count
+        uint32       shader, flags
+        uint32       uniform count
+            string       name; uint8 type; uint8[64] value; int32 unit; uint32 texture
+    uint32       font count
+        string       file path; float32 size; int32 padding; uint8 on edge value; int32 pixel dist scale
+        int32        bitmap size
+        uint32       codepoint count
+            uint32       codepoint
+    int32        skybox size
+    bytes        skybox pixels
+
+    uint32       renderable count
+        uint32       mesh, material; float32[3] position, rotation; float32 scale
+        uint8        has transformation; float32[16] transformation; float32[3] outline color
+    float32[12]  directional light
+    uint32       point light count
+        float32[14]  point light
+    float32[6]   left, right, bottom, top, near, far of light space; float32[3] position
+    uint32       text count
+        uint32       font; string; float32[2] position; float32[3] color; float32 scale; uint8 shadows
+    uint32       line count
+        float32[9]   p1, p2, color
+
+    A string or bytes is a uint32 size followed by the data. Missing resources are uint32 max. Everything is
+    written in the byte order of the machine. Textures are read back as they are, while vertex and index buffers
+    are read back from the GPU as bytes.
+*/
+
+namespace bb {
+    static constexpr char MAGIC[4] {'B', 'B', 'R', 'C'};
+    static constexpr std::uint32_t VERSION {1u};
+
+    template<typename T>
+    static void write(std::ofstream& stream, const T& value) {
+        stream.write(reinterpret_cast<const char*>(&value), sizeof(T));
+    }
+
+    template<typename T>
+    static T read(std::ifstream& stream) {
+        T value {};
+        stream.read(reinterpret_cast<char*>(&value), sizeof(T));
+
+        return value;
+    }
+
+    static void write_string(std::ofstream& stream, const std::string& string) {
+        write<std::uint32_t>(stream, static_cast<std::uint32_t>(string.size()));
+        stream.write(string.data(), static_cast<std::streamsize>(string.size()));
+    }
+
+    // Counts and sizes come from the file, so they are checked against what is left of it, with every element taking
+    // at least element_size bytes, before anything is allocated; a count that doesn't fit fails the stream
+    static std::uint32_t read_count(std::ifstream& stream, std::uint64_t file_size, std::uint64_t element_size) {
+        const std::uint32_t count {read<std::uint32_t>(stream)};
+
+        if (!stream) {
+            return 0u;
+        }
+
+        const std::uint64_t size_left {file_size - static_cast<std::uint64_t>(stream.tellg())};
+
+        if (static_cast<std::uint64_t>(count) * element_size > size_left) {
+            stream.setstate(std::ios::failbit);
+            return 0u;
+        }
+
+        return count;
+    }
+
+    static std::string read_string(std::ifstream& stream, std::uint64_t file_size) {
+        std::string string;
+        string.resize(read_count(stream, file_size, 1));
+        stream.read(string.data(), static_cast<std::streamsize>(string.size()));
+
+        return string;
+    }
+
+    static void write_bytes(std::ofstream& stream, const std::vector<unsigned char>& bytes) {
+        write<std::uint32_t>(stream, static_cast<std::uint32_t>(bytes.size()));
+        stream.write(reinterpret_cast<const char*>(bytes.data()), static_cast<std::streamsize>(bytes.size()));
+    }
+
+    static std::vector<unsigned char> read_bytes(std::ifstream& stream, std::uint64_t file_size) {
+        std::vector<unsigned char> bytes;
+        bytes.resize(read_count(stream, file_size, 1));
+        stream.read(reinterpret_cast<char*>(bytes.data()), static_cast<std::streamsize>(bytes.size()));
+
+        return bytes;
+    }
+
+    template<typename T>
+    static std::uint32_t find_taken(const std::vector<T>& taken, T resource) {
+        const auto iter {std::find(taken.begin(), taken.end(), resource)};
+
+        if (iter == taken.end()) {
+            return UINT32_MAX;
+        }
+
+        return static_cast<std::uint32_t>(std::distance(taken.begin(), iter));
+    }
+
+    // Through the copy target, as binding an index buffer would change the bound vertex array
+    static std::vector<unsigned char> read_buffer(unsigned int buffer) {
+        glBindBuffer(GL_COPY_READ_BUFFER, buffer);
+
+        int size {0};
+        glGetBufferParameteriv(GL_COPY_READ_BUFFER, GL_BUFFER_SIZE, &size);
+
+        std::vector<unsigned char> data;
+        data.resize(static_cast<std::size_t>(size));
+
+        glGetBufferSubData(GL_COPY_READ_BUFFER, 0, size, data.data());
+        glBindBuffer(GL_COPY_READ_BUFFER, 0);
+
+        return data;
+    }
+
+    // The pixels must have enough space for the whole level 0
+    static void read_texture(unsigned int target, unsigned int format, unsigned char* pixels) {
+        int alignment {4};
+        glGetIntegerv(GL_PACK_ALIGNMENT, &alignment);
+        glPixelStorei(GL_PACK_ALIGNMENT, 1);
+
+        glGetTexImage(target, 0, format, GL_UNSIGNED_BYTE, pixels);
+
+        glPixelStorei(GL_PACK_ALIGNMENT, alignment);
+    }
+
+    // Materials know their uniforms only by hash, but the names are in the shader
+    static const std::string* find_uniform_name(const std::vector<std::string>& uniforms, MaterialInstance::Key key) {
+        for (const std::string& name : uniforms) {
+            if (MaterialInstance::Key(name) == key) {
+                return &name;
+            }
+        }
+
+        return nullptr;
+    }
+
+    void RenderCapture::take(const Renderer& renderer) {
+        const FramebufferSpecification& specification {renderer.storage.scene_framebuffer->get_specification()};
+
+        width = specification.width;
+        height = specification.height;
+        samples = specification.samples;
+
+        view_matrix = renderer.camera.view_matrix;
+        projection_matrix = renderer.camera.projection_matrix;
+        projection_view_matrix = renderer.camera.projection_view_matrix;
+        position = renderer.camera.position;
+        projection_matrix_2d = renderer.camera_2d.projection_matrix;
+
+        Taken taken;
+
+        for (const Renderable& renderable : renderer.scene_list.renderables) {
+            const auto vertex_array {renderable.vertex_array.lock()};
+            const auto material {renderable.material.lock()};
+
+            // The renderer wouldn't draw these either
+            if (vertex_array == nullptr || material == nullptr) {
+                continue;
+            }
+
+            CapturedRenderable captured;
+            captured.mesh = take_mesh(vertex_array.get(), taken);
+            captured.material = take_material(material.get(), taken);
+            captured.position = renderable.position;
+            captured.rotation = renderable.rotation;
+            captured.scale = renderable.scale;
+            captured.has_transformation = renderable.transformation.has_value();
+            captured.transformation = renderable.transformation.value_or(glm::mat4(1.0f));
+            captured.outline_color = renderable.outline_color;
+
+            renderables.push_back(captured);
+        }
+
+        directional_light = renderer.scene_list.directional_light;
+        point_lights = renderer.scene_list.point_lights;
+
+        light_space.left = renderer.scene_list.light_space.left;
+        light_space.right = renderer.scene_list.light_space.right;
+        light_space.bottom = renderer.scene_list.light_space.bottom;
+        light_space.top = renderer.scene_list.light_space.top;
+        light_space.lens_near = renderer.scene_list.light_space.lens_near;
+        light_space.lens_far = renderer.scene_list.light_space.lens_far;
+        light_space.position = renderer.scene_list.light_space.position;
+
+        for (const Text& text : renderer.scene_list.strings) {
+            if (text.font == nullptr) {
+                continue;
+            }
+
+            CapturedText captured;
+            captured.font = take_font(text.font.get(), taken);
+            captured.string = text.string;
+            captured.position = text.position;
+            captured.color = text.color;
+            captured.scale = text.scale;
+            captured.shadows = text.shadows;
+
+            texts.push_back(std::move(captured));
+        }
+
+        for (const Renderer::Line& line : renderer.debug_scene_list) {
+            CapturedLine captured;
+            captured.p1 = line.p1;
+            captured.p2 = line.p2;
+            captured.color = line.color;
+
+            lines.push_back(captured);
+        }
+
+        if (renderer.storage.skybox_texture != nullptr) {
+            take_skybox(renderer.storage.skybox_texture->get_id());
+        }
+
+        BB_LOG_INFO(
+            Renderer,
+            "Took render capture with %zu renderables, %zu meshes, %zu materials and %zu textures\n",
+            renderables.size(),
+            meshes.size(),
+            materials.size(),
+            textures.size()
+        );
+    }
+
+    void RenderCapture::load(const std::string& file_path) {
+        std::ifstream stream {file_path, std::ios::binary};
+
+        if (!stream.is_open()) {
+            BB_LOG_ERROR(Renderer, "Could not open file `%s` for reading\n", file_path.c_str());
+            throw ResourceLoadingError;
+        }
+
+        stream.seekg(0, std::ios::end);
+        const std::uint64_t file_size {static_cast<std::uint64_t>(stream.tellg())};
+        stream.seekg(0, std::ios::beg);
+
+        char magic[4] {};
+        stream.read(magic, sizeof(magic));
+
+        if (std::memcmp(magic, MAGIC, sizeof(MAGIC)) != 0 || read<std::uint32_t>(stream) != VERSION) {
+            BB_LOG_ERROR(Renderer, "File `%s` is not a render capture\n", file_path.c_str());
+            throw ResourceLoadingError;
+        }
+
+        width = read<std::int32_t>(stream);
+        height = read<std::int32_t>(stream);
+        samples = read<std::int32_t>(stream);
+
+        view_matrix = read<glm::mat4>(stream);
+        projection_matrix = read<glm::mat4>(stream);
+        projection_view_matrix = read<glm::mat4>(stream);
+        position = read<glm::vec3>(stream);
+        projection_matrix_2d = read<glm::mat4>(stream);
+
+        shaders.resize(read_count(stream, file_size, 3 * sizeof(std::uint32_t)));  // Three strings
+
+        for (CapturedShader& shader : shaders) {
+            shader.vertex_path = read_string(stream, file_size);
+            shader.fragment_path = read_string(stream, file_size);
+            shader.includes_path = read_string(stream, file_size);
+        }
+
+        meshes.resize(read_count(stream, file_size, 2 * sizeof(std::uint32_t)));
+
+        for (CapturedMesh& mesh : meshes) {
+            mesh.vertex_buffers.resize(read_count(stream, file_size, 3 * sizeof(std::uint32_t)));
+
+            for (CapturedMesh::Buffer& buffer : mesh.vertex_buffers) {
+                const std::uint32_t element_count {read<std::uint32_t>(stream)};
+
+                for (std::uint32_t i {0}; stream && i < element_count; i++) {
+                    VertexBufferLayout::VertexElement element;
+                    element.index = read<std::uint32_t>(stream);
+                    element.type = static_cast<VertexBufferLayout::Type>(read<std::uint8_t>(stream));
+                    element.size = read<std::int32_t>(stream);
+                    element.per_instance = read<std::uint8_t>(stream) != 0;
+
+                    buffer.layout.elements.push_back(element);
+                }
+
+                buffer.layout.stride = read<std::int32_t>(stream);
+                buffer.data = read_bytes(stream, file_size);
+            }
+
+            mesh.indices = read_bytes(stream, file_size);
+        }
+
+        textures.resize(read_count(stream, file_size, 8 * sizeof(std::uint32_t)));
+
+        for (CapturedTexture& texture : textures) {
+            texture.width = read<std::int32_t>(stream);
+            texture.height = read<std::int32_t>(stream);
+            texture.specification.format = static_cast<Format>(read<std::uint8_t>(stream));
+            texture.specification.min_filter = static_cast<Filter>(read<std::uint8_t>(stream));
+            texture.specification.mag_filter = static_cast<Filter>(read<std::uint8_t>(stream));
+            texture.specification.wrap_s = static_cast<Wrap>(read<std::uint8_t>(stream));
+            texture.specification.wrap_t = static_cast<Wrap>(read<std::uint8_t>(stream));
+            texture.specification.border_color = read<glm::vec4>(stream);
+            texture.specification.mipmap_levels = read<std::int32_t>(stream);
+            texture.specification.bias = read<float>(stream);
+            texture.pixels = read_bytes(stream, file_size);
+        }
+
+        materials.resize(read_count(stream, file_size, 3 * sizeof(std::uint32_t)));
+
+        for (CapturedMaterial& material : materials) {
+            material.shader = read<std::uint32_t>(stream);
+            material.flags = read<std::uint32_t>(stream);
+            material.uniforms.resize(
+                read_count(stream, file_size, 3 * sizeof(std::uint32_t) + sizeof(CapturedMaterial::Uniform::value))
+            );
+
+            for (CapturedMaterial::Uniform& uniform : material.uniforms) {
+                uniform.name = read_string(stream, file_size);
+                uniform.type = read<std::uint8_t>(stream);
+                stream.read(reinterpret_cast<char*>(uniform.value), sizeof(uniform.value));
+                uniform.unit = read<std::int32_t>(stream);
+                uniform.texture = read<std::uint32_t>(stream);
+            }
+        }
+
+        fonts.resize(read_count(stream, file_size, 6 * sizeof(std::uint32_t)));
+
+        for (CapturedFont& font : fonts) {
+            font.file_path = read_string(stream, file_size);
+            font.size = read<float>(stream);
+            font.padding = read<std::int32_t>(stream);
+            font.on_edge_value = read<std::uint8_t>(stream);
+            font.pixel_dist_scale = read<std::int32_t>(stream);
+            font.bitmap_size = read<std::int32_t>(stream);
+            font.codepoints.resize(read_count(stream, file_size, sizeof(std::uint32_t)));
+
+            for (std::uint32_t& codepoint : font.codepoints) {
+                codepoint = read<std::uint32_t>(stream);
+            }
+        }
+
+        skybox_size = read<std::int32_t>(stream);
+        skybox_pixels = read_bytes(stream, file_size);
+
+        renderables.resize(read_count(stream, file_size, 2 * sizeof(std::uint32_t) + sizeof(glm::mat4)));
+
+        for (CapturedRenderable& renderable : renderables) {
+            renderable.mesh = read<std::uint32_t>(stream);
+            renderable.material = read<std::uint32_t>(stream);
+            renderable.position = read<glm::vec3>(stream);
+            renderable.rotation = read<glm::vec3>(stream);
+            renderable.scale = read<float>(stream);
+            renderable.has_transformation = read<std::uint8_t>(stream) != 0;
+            renderable.transformation = read<glm::mat4>(stream);
+            renderable.outline_color = read<glm::vec3>(stream);
+        }
+
+        directional_light = read<DirectionalLight>(stream);
+        point_lights.resize(read_count(stream, file_size, sizeof(PointLight)));
+
+        for (PointLight& light : point_lights) {
+            light = read<PointLight>(stream);
+        }
+
+        light_space = read<LightSpace>(stream);
+
+        texts.resize(read_count(stream, file_size, 2 * sizeof(std::uint32_t)));
+
+        for (CapturedText& text : texts) {
+            text.font = read<std::uint32_t>(stream);
+            text.string = read_string(stream, file_size);
+            text.position = read<glm::vec2>(stream);
+            text.color = read<glm::vec3>(stream);
+            text.scale = read<float>(stream);
+            text.shadows = read<std::uint8_t>(stream) != 0;
+        }
+
+        lines.resize(read_count(stream, file_size, sizeof(CapturedLine)));
+
+        for (CapturedLine& line : lines) {
+            line = read<CapturedLine>(stream);
+        }
+
+        if (!stream) {
+            BB_LOG_ERROR(Renderer, "Render capture `%s` is truncated\n", file_path.c_str());
+            throw ResourceLoadingError;
+        }
+
+        if (!is_valid()) {
+            BB_LOG_ERROR(Renderer, "Render capture `%s` is corrupted\n", file_path.c_str());
+            throw ResourceLoadingError;
+        }
+
+        BB_LOG_INFO(
+            Renderer,
+            "Loaded render capture `%s` with %zu renderables\n",
+            file_path.c_str(),
+            renderables.size()
+        );
+    }
+
+    bool RenderCapture::save(const std::string& file_path) const {
+        std::ofstream stream {file_path, std::ios::binary | std::ios::trunc};
+
+        if (!stream.is_open()) {
+            BB_LOG_ERROR(Renderer, "Could not open file `%s` for writing\n", file_path.c_str());
+            return false;
+        }
+
+        stream.write(MAGIC, sizeof(MAGIC));
+        write<std::uint32_t>(stream, VERSION);
+        write<std::int32_t>(stream, width);
+        write<std::int32_t>(stream, height);
+        write<std::int32_t>(stream, samples);
+
+        write<glm::mat4>(stream, view_matrix);
+        write<glm::mat4>(stream, projection_matrix);
+        write<glm::mat4>(stream, projection_view_matrix);
+        write<glm::vec3>(stream, position);
+        write<glm::mat4>(stream, projection_matrix_2d);
+
+        write<std::uint32_t>(stream, static_cast<std::uint32_t>(shaders.size()));
+
+        for (const CapturedShader& shader : shaders) {
+            write_string(stream, shader.vertex_path);
+            write_string(stream, shader.fragment_path);
+            write_string(stream, shader.includes_path);
+        }
+
+        write<std::uint32_t>(stream, static_cast<std::uint32_t>(meshes.size()));
+
+        for (const CapturedMesh& mesh : meshes) {
+            write<std::uint32_t>(stream, static_cast<std::uint32_t>(mesh.vertex_buffers.size()));
+
+            for (const CapturedMesh::Buffer& buffer : mesh.vertex_buffers) {
+                write<std::uint32_t>(stream, static_cast<std::uint32_t>(buffer.layout.elements.size()));
+
+                for (const VertexBufferLayout::VertexElement& element : buffer.layout.elements) {
+                    write<std::uint32_t>(stream, element.index);
+                    write<std::uint8_t>(stream, static_cast<std::uint8_t>(element.type));
+                    write<std::int32_t>(stream, element.size);
+                    write<std::uint8_t>(stream, element.per_instance);
+                }
+
+                write<std::int32_t>(stream, buffer.layout.stride);
+                write_bytes(stream, buffer.data);
+            }
+
+            write_bytes(stream, mesh.indices);
+        }
+
+        write<std::uint32_t>(stream, static_cast<std::uint32_t>(textures.size()));
+
+        for (const CapturedTexture& texture : textures) {
+            write<std::int32_t>(stream, texture.width);
+            write<std::int32_t>(stream, texture.height);
+            write<std::uint8_t>(stream, static_cast<std::uint8_t>(texture.specification.format));
+            write<std::uint8_t>(stream, static_cast<std::uint8_t>(texture.specification.min_filter));
+            write<std::uint8_t>(stream, static_cast<std::uint8_t>(texture.specification.mag_filter));
+            write<std::uint8_t>(stream, static_cast<std::uint8_t>(texture.specification.wrap_s));
+            write<std::uint8_t>(stream, static_cast<std::uint8_t>(texture.specification.wrap_t));
+            write<glm::vec4>(stream, texture.specification.border_color.value_or(glm::vec4(0.0f)));
+            write<std::int32_t>(stream, texture.specification.mipmap_levels);
+            write<float>(stream, texture.specification.bias);
+            write_bytes(stream, texture.pixels);
+        }
+
+        write<std::uint32_t>(stream, static_cast<std::uint32_t>(materials.size()));
+
+        for (const CapturedMaterial& material : materials) {
+            write<std::uint32_t>(stream, material.shader);
+            write<std::uint32_t>(stream, material.flags);
+            write<std::uint32_t>(stream, static_cast<std::uint32_t>(material.uniforms.size()));
+
+            for (const CapturedMaterial::Uniform& uniform : material.uniforms) {
+                write_string(stream, uniform.name);
+                write<std::uint8_t>(stream, uniform.type);
+                stream.write(reinterpret_cast<const char*>(uniform.value), sizeof(uniform.value));
+                write<std::int32_t>(stream, uniform.unit);
+                write<std::uint32_t>(stream, uniform.texture);
+            }
+        }
+
+        write<std::uint32_t>(stream, static_cast<std::uint32_t>(fonts.size()));
+
+        for (const CapturedFont& font : fonts) {
+            write_string(stream, font.file_path);
+            write<float>(stream, font.size);
+            write<std::int32_t>(stream, font.padding);
+            write<std::uint8_t>(stream, font.on_edge_value);
+            write<std::int32_t>(stream, font.pixel_dist_scale);
+            write<std::int32_t>(stream, font.bitmap_size);
+            write<std::uint32_t>(stream, static_cast<std::uint32_t>(font.codepoints.size()));
+
+            for (const std::uint32_t codepoint : font.codepoints) {
+                write<std::uint32_t>(stream, codepoint);
+            }
+        }
+
+        write<std::int32_t>(stream, skybox_size);
+        write_bytes(stream, skybox_pixels);
+
+        write<std::uint32_t>(stream, static_cast<std::uint32_t>(renderables.size()));
+
+        for (const CapturedRenderable& renderable : renderables) {
+            write<std::uint32_t>(stream, renderable.mesh);
+            write<std::uint32_t>(stream, renderable.material);
+            write<glm::vec3>(stream, renderable.position);
+            write<glm::vec3>(stream, renderable.rotation);
+            write<float>(stream, renderable.scale);
+            write<std::uint8_t>(stream, renderable.has_transformation);
+            write<glm::mat4>(stream, renderable.transformation);
+            write<glm::vec3>(stream, renderable.outline_color);
+        }
+
+        write<DirectionalLight>(stream, directional_light);
+        write<std::uint32_t>(stream, static_cast<std::uint32_t>(point_lights.size()));
+
+        for (const PointLight& light : point_lights) {
+            write<PointLight>(stream, light);
+        }
+
+        write<LightSpace>(stream, light_space);
+
+        write<std::uint32_t>(stream, static_cast<std::uint32_t>(texts.size()));
+
+        for (const CapturedText& text : texts) {
+            write<std::uint32_t>(stream, text.font);
+            write_string(stream, text.string);
+            write<glm::vec2>(stream, text.position);
+            write<glm::vec3>(stream, text.color);
+            write<float>(stream, text.scale);
+            write<std::uint8_t>(stream, text.shadows);
+        }
+
+        write<std::uint32_t>(stream, static_cast<std::uint32_t>(lines.size()));
+
+        for (const CapturedLine& line : lines) {
+            write<CapturedLine>(stream, line);
+        }
+
+        if (!stream) {
+            BB_LOG_ERROR(Renderer, "Could not write render capture `%s`\n", file_path.c_str());
+            return false;
+        }
+
+        BB_LOG_INFO(Renderer, "Saved render capture `%s`\n", file_path.c_str());
+
+        return true;
+    }
+
+    void RenderCapture::create_resources(Renderer& renderer) {
+        for (const CapturedShader& captured : shaders) {
+            std::shared_ptr<Shader> shader;
+
+            if (captured.includes_path.empty()) {
+                shader = std::make_shared<Shader>(captured.vertex_path, captured.fragment_path);
+            } else {
+                shader = std::make_shared<Shader>(captured.vertex_path, captured.fragment_path, captured.includes_path);
+            }
+
+            renderer.add_shader(shader);
+            resources.shaders.push_back(shader);
+        }
+
+        for (const CapturedMesh& captured : meshes) {
+            auto vertex_array {std::make_shared<VertexArray>()};
+
+            vertex_array->configure([&](VertexArray* va) {
+                for (const CapturedMesh::Buffer& buffer : captured.vertex_buffers) {
+                    va->add_vertex_buffer(
+                        std::make_shared<VertexBuffer>(buffer.data.data(), buffer.data.size()),
+                        buffer.layout
+                    );
+                }
+
+                va->add_index_buffer(std::make_shared<IndexBuffer>(captured.indices.data(), captured.indices.size()));
+            });
+
+            resources.meshes.push_back(vertex_array);
+        }
+
+        for (const CapturedTexture& captured : textures) {
+            // The texture doesn't keep the data
+            std::vector<unsigned char> pixels {captured.pixels};
+
+            resources.textures.push_back(
+                std::make_shared<Texture>(captured.width, captured.height, pixels.data(), captured.specification)
+            );
+        }
+
+        for (const CapturedMaterial& captured : materials) {
+            using ElementType = MaterialInstance::Element::Type;
+
+            auto material {std::make_shared<Material>(resources.shaders[captured.shader])};
+
+            for (const CapturedMaterial::Uniform& uniform : captured.uniforms) {
+                const MaterialInstance::Key key {uniform.name};
+
+                switch (static_cast<ElementType>(uniform.type)) {
+                    case ElementType::Mat4:
+                        material->add_uniform(Material::Uniform::Mat4, key);
+                        break;
+                    case ElementType::Int:
+                        material->add_uniform(Material::Uniform::Int, key);
+                        break;
+                    case ElementType::Float:
+                        material->add_uniform(Material::Uniform::Float, key);
+                        break;
+                    case ElementType::Vec2:
+                        material->add_uniform(Material::Uniform::Vec2, key);
+                        break;
+                    case ElementType::Vec3:
+                        material->add_uniform(Material::Uniform::Vec3, key);
+                        break;
+                    case ElementType::Vec4:
+                        material->add_uniform(Material::Uniform::Vec4, key);
+                        break;
+                    case ElementType::Texture:
+                        material->add_texture(key);
+                        break;
+                }
+            }
+
+            auto material_instance {std::make_shared<MaterialInstance>(material)};
+            material_instance->flags = captured.flags;
+
+            for (const CapturedMaterial::Uniform& uniform : captured.uniforms) {
+                const MaterialInstance::Key key {uniform.name};
+
+                if (static_cast<ElementType>(uniform.type) == ElementType::Texture) {
+                    const unsigned int texture {
+                        uniform.texture == NONE ? 0u : resources.textures[uniform.texture]->get_id()
+                    };
+
+                    material_instance->set_texture(key, texture, uniform.unit);
+                } else {
+                    const MaterialInstance::Element& element {material_instance->offsets.at(key)};
+                    std::memcpy(material_instance->data + element.offset, uniform.value, get_uniform_size(uniform.type));
+                }
+            }
+
+            resources.materials.push_back(material_instance);
+        }
+
+        for (const CapturedFont& captured : fonts) {
+            auto font {std::make_shared<Font>(
+                captured.file_path,
+                captured.size,
+                captured.padding,
+                captured.on_edge_value,
+                captured.pixel_dist_scale,
+                captured.bitmap_size
+            )};
+
+            font->begin_baking();
+
+            for (const std::uint32_t codepoint : captured.codepoints) {
+                // Some are baked in the beginning
+                if (font->glyphs.count(codepoint) == 0) {
+                    font->bake_character(static_cast<int>(codepoint));
+                }
+            }
+
+            font->end_baking();
+
+            resources.fonts.push_back(font);
+        }
+
+        if (skybox_size > 0) {
+            const std::size_t face_size {static_cast<std::size_t>(skybox_size * skybox_size * 4)};
+
+            std::array<const unsigned char*, 6> faces {};
+
+            for (std::size_t i {0}; i < 6; i++) {
+                faces[i] = skybox_pixels.data() + i * face_size;
+            }
+
+            resources.skybox = std::make_shared<TextureCubemap>(skybox_size, skybox_size, faces);
+        }
+
+        renderer.skybox(resources.skybox);
+        renderer.prerender_setup();
+    }
+
+    void RenderCapture::replay(Renderer& renderer) const {
+        renderer.camera.view_matrix = view_matrix;
+        renderer.camera.projection_matrix = projection_matrix;
+        renderer.camera.projection_view_matrix = projection_view_matrix;
+        renderer.camera.position = position;
+        renderer.camera_2d.projection_matrix = projection_matrix_2d;
+
+        for (const CapturedRenderable& captured : renderables) {
+            Renderable renderable;
+            renderable.vertex_array = resources.meshes[captured.mesh];
+            renderable.material = resources.materials[captured.material];
+            renderable.position = captured.position;
+            renderable.rotation = captured.rotation;
+            renderable.scale = captured.scale;
+            renderable.outline_color = captured.outline_color;
+
+            if (captured.has_transformation) {
+                renderable.transformation = captured.transformation;
+            }
+
+            renderer.add_renderable(renderable);
+        }
+
+        renderer.add_light(directional_light);
+
+        for (const PointLight& light : point_lights) {
+            renderer.add_light(light);
+        }
+
+        renderer.shadows(
+            light_space.left,
+            light_space.right,
+            light_space.bottom,
+            light_space.top,
+            light_space.lens_near,
+            light_space.lens_far,
+            light_space.position
+        );
+
+        for (const CapturedText& captured : texts) {
+            Text text;
+            text.font = resources.fonts[captured.font];
+            text.string = captured.string;
+            text.position = captured.position;
+            text.color = captured.color;
+            text.scale = captured.scale;
+            text.shadows = captured.shadows;
+
+            renderer.add_text(text);
+        }
+
+        for (const CapturedLine& line : lines) {
+            renderer.debug_add_line(line.p1, line.p2, line.color);
+        }
+
+        renderer.render();
+    }
+
+    std::uint32_t RenderCapture::take_mesh(const VertexArray* vertex_array, Taken& taken) {
+        const std::uint32_t index {find_taken(taken.meshes, vertex_array)};
+
+        if (index != NONE) {
+            return index;
+        }
+
+        CapturedMesh captured;
+
+        for (std::size_t i {0}; i < vertex_array->vertex_buffers.size(); i++) {
+            CapturedMesh::Buffer buffer;
+            buffer.layout = vertex_array->layouts[i];
+            buffer.data = read_buffer(vertex_array->vertex_buffers[i]->buffer);
+
+            captured.vertex_buffers.push_back(std::move(buffer));
+        }
+
+        // Every renderable is drawn with indices
+        captured.indices = read_buffer(vertex_array->index_buffer->buffer);
+
+        taken.meshes.push_back(vertex_array);
+        meshes.push_back(std::move(captured));
+
+        return static_cast<std::uint32_t>(meshes.size() - 1);
+    }
+
+    std::uint32_t RenderCapture::take_material(const MaterialInstance* material, Taken& taken) {
+        const std::uint32_t index {find_taken(taken.materials, material)};
+
+        if (index != NONE) {
+            return index;
+        }
+
+        CapturedMaterial captured;
+        captured.shader = take_shader(material->shader.get(), taken);
+        captured.flags = material->flags;
+
+        for (const auto& [key, element] : material->offsets) {
+            const std::string* name {find_uniform_name(material->shader->uniforms, key)};
+
+            // Not active in the program, so it doesn't matter
+            if (name == nullptr) {
+                continue;
+            }
+
+            CapturedMaterial::Uniform uniform;
+            uniform.name = *name;
+            uniform.type = static_cast<std::uint8_t>(element.type);
+
+            if (element.type == MaterialInstance::Element::Type::Texture) {
+                MaterialInstance::TextureUnit texture;
+                std::memcpy(&texture, material->data + element.offset, sizeof(texture));
+
+                uniform.unit = texture.unit;
+                uniform.texture = take_texture(texture.texture, taken);
+            } else {
+                std::memcpy(uniform.value, material->data + element.offset, get_uniform_size(uniform.type));
+            }
+
+            captured.uniforms.push_back(std::move(uniform));
+        }
+
+        taken.materials.push_back(material);
+        materials.push_back(std::move(captured));
+
+        return static_cast<std::uint32_t>(materials.size() - 1);
+    }
+
+    std::uint32_t RenderCapture::take_shader(const Shader* shader, Taken& taken) {
+        const std::uint32_t index {find_taken(taken.shaders, shader)};
+
+        if (index != NONE) {
+            return index;
+        }
+
+        CapturedShader captured;
+        captured.vertex_path = shader->source_vertex_path;
+        captured.fragment_path = shader->source_fragment_path;
+        captured.includes_path = shader->includes_path;
+
+        taken.shaders.push_back(shader);
+        shaders.push_back(std::move(captured));
+
+        return static_cast<std::uint32_t>(shaders.size() - 1);
+    }
+
+    std::uint32_t RenderCapture::take_texture(unsigned int texture, Taken& taken) {
+        if (texture == 0 || glIsTexture(texture) == GL_FALSE) {
+            return NONE;
+        }
+
+        const std::uint32_t index {find_taken(taken.textures, texture)};
+
+        if (index != NONE) {
+            return index;
+        }
+
+        glBindTexture(GL_TEXTURE_2D, texture);
+
+        int internal_format {0};
+        int texture_width {0};
+        int texture_height {0};
+        glGetTexLevelParameteriv(GL_TEXTURE_2D, 0, GL_TEXTURE_INTERNAL_FORMAT, &internal_format);
+        glGetTexLevelParameteriv(GL_TEXTURE_2D, 0, GL_TEXTURE_WIDTH, &texture_width);
+        glGetTexLevelParameteriv(GL_TEXTURE_2D, 0, GL_TEXTURE_HEIGHT, &texture_height);
+
+        int min_filter {0};
+        int mag_filter {0};
+        int wrap_s {0};
+        int wrap_t {0};
+        int levels {0};
+        glGetTexParameteriv(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, &min_filter);
+        glGetTexParameteriv(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, &mag_filter);
+        glGetTexParameteriv(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, &wrap_s);
+        glGetTexParameteriv(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, &wrap_t);
+        glGetTexParameteriv(GL_TEXTURE_2D, GL_TEXTURE_IMMUTABLE_LEVELS, &levels);
+
+        glm::vec4 border_color {};
+        float bias {0.0f};
+        glGetTexParameterfv(GL_TEXTURE_2D, GL_TEXTURE_BORDER_COLOR, &border_color.x);
+        glGetTexParameterfv(GL_TEXTURE_2D, GL_TEXTURE_LOD_BIAS, &bias);
+
+        const auto to_filter {[](int filter) {
+            return filter == GL_NEAREST ? Filter::Nearest : Filter::Linear;
+        }};
+
+        const auto to_wrap {[](int wrap) {
+            switch (wrap) {
+                case GL_REPEAT:
+                    return Wrap::Repeat;
+                case GL_CLAMP_TO_EDGE:
+                    return Wrap::ClampEdge;
+                default:
+                    return Wrap::ClampBorder;
+            }
+        }};
+
+        CapturedTexture captured;
+        captured.width = texture_width;
+        captured.height = texture_height;
+        captured.specification.min_filter = to_filter(min_filter);
+        captured.specification.mag_filter = to_filter(mag_filter);
+        captured.specification.wrap_s = to_wrap(wrap_s);
+        captured.specification.wrap_t = to_wrap(wrap_t);
+        captured.specification.border_color = border_color;
+        captured.specification.mipmap_levels = std::max(levels, 1);
+        captured.specification.bias = bias;
+
+        unsigned int pixel_format {0};
+        std::size_t channels {0};
+
+        switch (internal_format) {
+            case GL_RGBA8:
+                captured.specification.format = Format::Rgba8;
+                pixel_format = GL_RGBA;
+                channels = 4;
+                break;
+            case GL_RGB8:
+                captured.specification.format = Format::Rgb8;
+                pixel_format = GL_RGB;
+                channels = 3;
+                break;
+            case GL_R8:
+                captured.specification.format = Format::R8;
+                pixel_format = GL_RED;
+                channels = 1;
+                break;
+            default:
+                glBindTexture(GL_TEXTURE_2D, 0);
+
+                // Framebuffer attachments, for example
+                BB_LOG_WARNING(Renderer, "Texture %u has a format that can't be captured\n", texture);
+
+                return NONE;
+        }
+
+        captured.pixels.resize(
+            static_cast<std::size_t>(texture_width) * static_cast<std::size_t>(texture_height) * channels
+        );
+        read_texture(GL_TEXTURE_2D, pixel_format, captured.pixels.data());
+
+        glBindTexture(GL_TEXTURE_2D, 0);
+
+        taken.textures.push_back(texture);
+        textures.push_back(std::move(captured));
+
+        return static_cast<std::uint32_t>(textures.size() - 1);
+    }
+
+    std::uint32_t RenderCapture::take_font(const Font* font, Taken& taken) {
+        const std::uint32_t index {find_taken(taken.fonts, font)};
+
+        if (index != NONE) {
+            return index;
+        }
+
+        CapturedFont captured;
+        captured.file_path = font->file_path;
+        captured.size = font->font_size;
+        captured.padding = font->padding;
+        captured.on_edge_value = font->on_edge_value;
+        captured.pixel_dist_scale = font->pixel_dist_scale;
+        captured.bitmap_size = font->bitmap_size;
+
+        for (const auto& [codepoint, _] : font->glyphs) {
+            captured.codepoints.push_back(static_cast<std::uint32_t>(codepoint));
+        }
+
+        // The order of the map is unspecified
+        std::sort(captured.codepoints.begin(), captured.codepoints.end());
+
+        taken.fonts.push_back(font);
+        fonts.push_back(std::move(captured));
+
+        return static_cast<std::uint32_t>(fonts.size() - 1);
+    }
+
+    void RenderCapture::take_skybox(unsigned int texture) {
+        glBindTexture(GL_TEXTURE_CUBE_MAP, texture);
+
+        glGetTexLevelParameteriv(GL_TEXTURE_CUBE_MAP_POSITIVE_X, 0, GL_TEXTURE_WIDTH, &skybox_size);
+
+        // Faces are square and RGBA
+        const std::size_t face_size {static_cast<std::size_t>(skybox_size * skybox_size * 4)};
+
+        skybox_pixels.resize(face_size * 6);
+
+        for (std::size_t i {0}; i < 6; i++) {
+            read_texture(
+                static_cast<unsigned int>(GL_TEXTURE_CUBE_MAP_POSITIVE_X + i),
+                GL_RGBA,
+                skybox_pixels.data() + i * face_size
+            );
+        }
+
+        glBindTexture(GL_TEXTURE_CUBE_MAP, 0);
+    }
+
+    std::size_t RenderCapture::get_uniform_size(std::uint8_t type) {
+        using ElementType = MaterialInstance::Element::Type;
+
+        std::size_t result {0};
+
+        switch (static_cast<ElementType>(type)) {
+            case ElementType::Mat4:
+                result = sizeof(glm::mat4);
+                break;
+            case ElementType::Int:
+                result = sizeof(int);
+                break;
+            case ElementType::Float:
+                result = sizeof(float);
+                break;
+            case ElementType::Vec2:
+                result = sizeof(glm::vec2);
+                break;
+            case ElementType::Vec3:
+                result = sizeof(glm::vec3);
+                break;
+            case ElementType::Vec4:
+                result = sizeof(glm::vec4);
+                break;
+            case ElementType::Texture:
+                break;
+        }
+
+        return result;
+    }
+
+    bool RenderCapture::is_valid() const {
+        using ElementType = MaterialInstance::Element::Type;
+
+        for (const CapturedMesh& mesh : meshes) {
+            if (mesh.indices.empty()) {
+                return false;
+            }
+
+            for (const CapturedMesh::Buffer& buffer : mesh.vertex_buffers) {
+                for (const VertexBufferLayout::VertexElement& element : buffer.layout.elements) {
+                    if (element.type != VertexBufferLayout::Float && element.type != VertexBufferLayout::Int) {
+                        return false;
+                    }
+                }
+            }
+        }
+
+        for (const CapturedTexture& texture : textures) {
+            std::size_t channels {0};
+
+            switch (texture.specification.format) {
+                case Format::Rgba8:
+                    channels = 4;
+                    break;
+                case Format::Rgb8:
+                    channels = 3;
+                    break;
+                case Format::R8:
+                    channels = 1;
+                    break;
+            }
+
+            const auto size {
+                static_cast<std::size_t>(texture.width) * static_cast<std::size_t>(texture.height) * channels
+            };
+
+            if (texture.width <= 0 || texture.height <= 0 || texture.pixels.size() != size) {
+                return false;
+            }
+        }
+
+        for (const CapturedMaterial& material : materials) {
+            if (material.shader >= shaders.size()) {
+                return false;
+            }
+
+            for (const CapturedMaterial::Uniform& uniform : material.uniforms) {
+                if (uniform.type > static_cast<std::uint8_t>(ElementType::Texture)) {
+                    return false;
+                }
+
+                if (uniform.texture != NONE && uniform.texture >= textures.size()) {
+                    return false;
+                }
+            }
+        }
+
+        for (const CapturedRenderable& renderable : renderables) {
+            if (renderable.mesh >= meshes.size() || renderable.material >= materials.size()) {
+                return false;
+            }
+        }
+
+        for (const CapturedText& text : texts) {
+            if (text.font >= fonts.size()) {
+                return false;
+            }
+        }
+
+        const auto face_size {static_cast<std::size_t>(skybox_size) * static_cast<std::size_t>(skybox_size) * 4};
+
+        return skybox_size >= 0 && skybox_pixels.size() == face_size * 6;
+    }
+}
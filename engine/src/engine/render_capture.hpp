@@ -0,0 +1,205 @@
+#pragma once
+
+#include <string>
+#include <vector>
+#include <memory>
+#include <cstddef>
+#include <cstdint>
+
+#include <glm/glm.hpp>
+
+#include "engine/light.hpp"
+#include "engine/texture.hpp"
+#include "engine/vertex_buffer_layout.hpp"
+
+namespace bb {
+    class Renderer;
+    class Shader;
+    class VertexArray;
+    class MaterialInstance;
+    class Font;
+
+    /*
+        Everything the renderer draws in one frame: the scene list, the cameras and the resources that these
+        reference, read back from the GPU. A capture is written to a file in the game and replayed offline, so that
+        the renderer can be measured without playing the game. The overlay is not captured.
+
+        Shaders are recreated from their source files and fonts from their font files, so that changes to them are
+        picked up by the replay.
+    */
+    class RenderCapture {
+    public:
+        RenderCapture() = default;
+        ~RenderCapture() = default;
+
+        RenderCapture(const RenderCapture&) = delete;
+        RenderCapture& operator=(const RenderCapture&) = delete;
+        RenderCapture(RenderCapture&&) = delete;
+        RenderCapture& operator=(RenderCapture&&) = delete;
+
+        // Copy what was submitted to the renderer in the current frame, before it renders
+        void take(const Renderer& renderer);
+
+        void load(const std::string& file_path);
+
+        // Return false, if the file couldn't be written
+        bool save(const std::string& file_path) const;
+
+        // Create the resources on the GPU; the renderer must have the size and the samples of the capture
+        void create_resources(Renderer& renderer);
+
+        // Submit the captured frame and render it
+        void replay(Renderer& renderer) const;
+
+        int get_width() const { return width; }
+        int get_height() const { return height; }
+        int get_samples() const { return samples; }
+        std::size_t get_renderable_count() const { return renderables.size(); }
+    private:
+        static constexpr std::uint32_t NONE {UINT32_MAX};  // A missing resource
+
+        struct CapturedShader {
+            std::string vertex_path;
+            std::string fragment_path;
+            std::string includes_path;  // Empty, if there are no includes
+        };
+
+        struct CapturedMesh {
+            struct Buffer {
+                VertexBufferLayout layout;
+                std::vector<unsigned char> data;
+            };
+
+            std::vector<Buffer> vertex_buffers;
+            std::vector<unsigned char> indices;
+        };
+
+        struct CapturedTexture {
+            int width {0};
+            int height {0};
+            TextureSpecification specification;
+            std::vector<unsigned char> pixels;
+        };
+
+        struct CapturedMaterial {
+            struct Uniform {
+                std::string name;
+                std::uint8_t type {0};  // MaterialInstance::Element::Type
+                unsigned char value[sizeof(glm::mat4)] {};
+                std::int32_t unit {0};
+                std::uint32_t texture {NONE};
+            };
+
+            std::uint32_t shader {NONE};
+            std::uint32_t flags {0};
+            std::vector<Uniform> uniforms;
+        };
+
+        struct CapturedFont {
+            std::string file_path;
+            float size {0.0f};
+            std::int32_t padding {0};
+            std::uint8_t on_edge_value {0};
+            std::int32_t pixel_dist_scale {0};
+            std::int32_t bitmap_size {0};
+            std::vector<std::uint32_t> codepoints;
+        };
+
+        struct CapturedRenderable {
+            std::uint32_t mesh {NONE};
+            std::uint32_t material {NONE};
+            glm::vec3 position {};
+            glm::vec3 rotation {};
+            float scale {1.0f};
+            bool has_transformation {false};
+            glm::mat4 transformation {1.0f};
+            glm::vec3 outline_color {};
+        };
+
+        struct CapturedText {
+            std::uint32_t font {NONE};
+            std::string string;
+            glm::vec2 position {};
+            glm::vec3 color {};
+            float scale {1.0f};
+            bool shadows {false};
+        };
+
+        struct CapturedLine {
+            glm::vec3 p1 {};
+            glm::vec3 p2 {};
+            glm::vec3 color {};
+        };
+
+        struct LightSpace {
+            float left {0.0f};
+            float right {0.0f};
+            float bottom {0.0f};
+            float top {0.0f};
+            float lens_near {1.0f};
+            float lens_far {1.0f};
+            glm::vec3 position {};
+        };
+
+        // Resources already captured, in the order they were captured
+        struct Taken {
+            std::vector<const VertexArray*> meshes;
+            std::vector<const MaterialInstance*> materials;
+            std::vector<const Shader*> shaders;
+            std::vector<unsigned int> textures;
+            std::vector<const Font*> fonts;
+        };
+
+        std::uint32_t take_mesh(const VertexArray* vertex_array, Taken& taken);
+        std::uint32_t take_material(const MaterialInstance* material, Taken& taken);
+        std::uint32_t take_shader(const Shader* shader, Taken& taken);
+        std::uint32_t take_texture(unsigned int texture, Taken& taken);
+        std::uint32_t take_font(const Font* font, Taken& taken);
+        void take_skybox(unsigned int texture);
+
+        static std::size_t get_uniform_size(std::uint8_t type);
+
+        // Every resource that is referenced must exist
+        bool is_valid() const;
+
+        // Framebuffer
+        int width {0};
+        int height {0};
+        int samples {1};
+
+        // Cameras
+        glm::mat4 view_matrix {1.0f};
+        glm::mat4 projection_matrix {1.0f};
+        glm::mat4 projection_view_matrix {1.0f};
+        glm::vec3 position {};
+        glm::mat4 projection_matrix_2d {1.0f};
+
+        // Resources
+        std::vector<CapturedShader> shaders;
+        std::vector<CapturedMesh> meshes;
+        std::vector<CapturedTexture> textures;
+        std::vector<CapturedMaterial> materials;
+        std::vector<CapturedFont> fonts;
+
+        int skybox_size {0};  // No skybox, if 0
+        std::vector<unsigned char> skybox_pixels;  // All six faces, one after the other
+
+        // Scene list
+        std::vector<CapturedRenderable> renderables;
+        DirectionalLight directional_light;
+        std::vector<PointLight> point_lights;
+        LightSpace light_space;
+        std::vector<CapturedText> texts;
+        std::vector<CapturedLine> lines;
+
+        // Created from the above, only for replaying
+        struct {
+            std::vector<std::shared_ptr<Shader>> shaders;
+            std::vector<std::shared_ptr<VertexArray>> meshes;
+            std::vector<std::shared_ptr<Texture>> textures;
+            std::vector<std::shared_ptr<MaterialInstance>> materials;
+            std::vector<std::shared_ptr<Font>> fonts;
+            std::shared_ptr<TextureCubemap> skybox;
+        } resources;
+    };
+}
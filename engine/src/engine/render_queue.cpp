@@ -0,0 +1,204 @@
+#include <vector>
+#include <unordered_map>
+#include <utility>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+#include <glm/glm.hpp>
+
+#include "engine/render_queue.hpp"
+#include "engine/vertex_array.hpp"
+#include "engine/buffer.hpp"
+#include "engine/material.hpp"
+#include "engine/profiler.hpp"
+
+namespace bb {
+    static constexpr unsigned int PASS_SHIFT {62};
+    static constexpr unsigned int SHADER_SHIFT {50};
+    static constexpr unsigned int MATERIAL_SHIFT {36};
+    static constexpr unsigned int VERTEX_ARRAY_SHIFT {24};
+
+    static constexpr std::uint64_t MAX_SHADER {(1u << 12) - 1};
+    static constexpr std::uint64_t MAX_MATERIAL {(1u << 14) - 1};
+    static constexpr std::uint64_t MAX_VERTEX_ARRAY {(1u << 12) - 1};
+
+    // The bits of positive floats are in the same order as the floats themselves
+    static std::uint64_t depth_bits(const glm::mat4& view_matrix, const glm::vec3& position) {
+        float depth {-(view_matrix * glm::vec4(position, 1.0f)).z};
+
+        if (!(depth > 0.0f)) {
+            depth = 0.0f;
+        }
+
+        std::uint32_t bits;
+        std::memcpy(&bits, &depth, sizeof(bits));
+
+        return static_cast<std::uint64_t>(bits >> 7);  // The top 24 bits after the sign
+    }
+
+    void RenderQueue::build(
+        const std::vector<Renderable>& renderables,
+        const std::vector<glm::mat4>& matrices,
+        const glm::mat4& view_matrix
+    ) {
+        BB_PROFILE_SCOPE("RenderQueue::build");
+
+        clear();
+
+        packets.reserve(renderables.size() * PASSES);
+
+        for (std::size_t i {0}; i < renderables.size(); i++) {
+            const Renderable& renderable {renderables[i]};
+            const auto vertex_array {renderable.vertex_array.lock()};
+            const auto material {renderable.material.lock()};
+
+            const bool outline {(material->flags & Material::Outline) != 0};
+            const bool cast_shadow {(material->flags & Material::CastShadow) != 0};
+
+            if (outline && !cast_shadow) {
+                continue;  // Not drawn by any pass
+            }
+
+            DrawPacket packet;
+            packet.vertex_array = vertex_array.get();
+            packet.material = material.get();
+            packet.shader = material->get_shader();
+            packet.index_count = vertex_array->get_index_buffer()->get_index_count();
+            packet.matrix = static_cast<std::uint32_t>(i);
+
+            const std::uint64_t vertex_array_number {
+                number(packet.vertex_array, vertex_array_numbers, MAX_VERTEX_ARRAY)
+            };
+
+            if (cast_shadow) {
+                // Only the geometry matters to the shadow pass
+                packet.key = static_cast<std::uint64_t>(RenderPass::Shadow) << PASS_SHIFT;
+                packet.key |= vertex_array_number << VERTEX_ARRAY_SHIFT;
+
+                packets.push_back(packet);
+            }
+
+            if (!outline) {
+                packet.key = static_cast<std::uint64_t>(RenderPass::Scene) << PASS_SHIFT;
+                packet.key |= number(packet.shader, shader_numbers, MAX_SHADER) << SHADER_SHIFT;
+                packet.key |= number(packet.material, material_numbers, MAX_MATERIAL) << MATERIAL_SHIFT;
+                packet.key |= vertex_array_number << VERTEX_ARRAY_SHIFT;
+                packet.key |= depth_bits(view_matrix, glm::vec3(matrices[i][3]));
+
+                packets.push_back(packet);
+            }
+        }
+
+        sort(matrices);
+    }
+
+    void RenderQueue::clear() {
+        packets.clear();
+        sorted_packets.clear();
+        instance_matrices.clear();
+
+        for (std::size_t& begin : pass_begin) {
+            begin = 0;
+        }
+
+        shader_numbers.clear();
+        material_numbers.clear();
+        vertex_array_numbers.clear();
+    }
+
+    RenderQueue::Packets RenderQueue::get_packets(RenderPass pass) const {
+        const std::size_t index {static_cast<std::size_t>(pass)};
+
+        Packets result;
+        result.first = sorted_packets.data() + pass_begin[index];
+        result.last = sorted_packets.data() + pass_begin[index + 1];
+
+        return result;
+    }
+
+    std::uint64_t RenderQueue::number(
+        const void* resource,
+        std::unordered_map<const void*, std::uint64_t>& numbers,
+        std::uint64_t max
+    ) {
+        const auto [iter, inserted] {numbers.try_emplace(resource, numbers.size())};
+
+        return iter->second < max ? iter->second : max;
+    }
+
+    void RenderQueue::sort(const std::vector<glm::mat4>& matrices) {
+        BB_PROFILE_SCOPE("RenderQueue::sort");
+
+        static constexpr std::size_t DIGITS {8};
+        static constexpr std::size_t BUCKETS {256};
+
+        items.resize(packets.size());
+        scratch.resize(packets.size());
+
+        // Count all the digits in one go
+        std::size_t counts[DIGITS][BUCKETS] {};
+
+        for (std::size_t i {0}; i < packets.size(); i++) {
+            const std::uint64_t key {packets[i].key};
+
+            items[i].key = key;
+            items[i].packet = static_cast<std::uint32_t>(i);
+
+            for (std::size_t digit {0}; digit < DIGITS; digit++) {
+                counts[digit][(key >> (digit * 8)) & 0xFF]++;
+            }
+        }
+
+        // Least significant digit first, each pass keeping the order of the previous one
+        for (std::size_t digit {0}; digit < DIGITS; digit++) {
+            std::size_t* count {counts[digit]};
+
+            // Every key has the same digit, so there is nothing to move
+            if (items.empty() || count[(items[0].key >> (digit * 8)) & 0xFF] == items.size()) {
+                continue;
+            }
+
+            std::size_t offset {0};
+
+            for (std::size_t bucket {0}; bucket < BUCKETS; bucket++) {
+                const std::size_t bucket_count {count[bucket]};
+                count[bucket] = offset;
+                offset += bucket_count;
+            }
+
+            for (const SortItem& item : items) {
+                scratch[count[(item.key >> (digit * 8)) & 0xFF]++] = item;
+            }
+
+            std::swap(items, scratch);
+        }
+
+        sorted_packets.resize(packets.size());
+        instance_matrices.resize(packets.size());
+
+        for (std::size_t i {0}; i < items.size(); i++) {
+            DrawPacket& packet {sorted_packets[i]};
+
+            packet = packets[items[i].packet];
+            packet.instance = static_cast<std::uint32_t>(i);
+
+            instance_matrices[i] = matrices[packet.matrix];
+        }
+
+        // The passes are at the top of the keys, so every pass is one range
+        std::size_t pass {0};
+
+        for (std::size_t i {0}; i < sorted_packets.size(); i++) {
+            const std::size_t packet_pass {static_cast<std::size_t>(sorted_packets[i].key >> PASS_SHIFT)};
+
+            while (pass < packet_pass) {
+                pass_begin[++pass] = i;
+            }
+        }
+
+        while (pass < PASSES) {
+            pass_begin[++pass] = sorted_packets.size();
+        }
+    }
+}
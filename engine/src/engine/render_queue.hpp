@@ -0,0 +1,109 @@
+#pragma once
+
+#include <vector>
+#include <unordered_map>
+#include <cstddef>
+#include <cstdint>
+
+#include <glm/glm.hpp>
+
+#include "engine/renderable.hpp"
+
+namespace bb {
+    class VertexArray;
+    class MaterialInstance;
+    class Shader;
+
+    enum class RenderPass : unsigned int {
+        Shadow,
+        Scene
+    };
+
+    // One draw of a renderable in one pass, with everything needed to draw it without following the renderable
+    struct DrawPacket {
+        std::uint64_t key {0};
+        VertexArray* vertex_array {nullptr};  // Gets the instance buffer, when it's first drawn instanced
+        const MaterialInstance* material {nullptr};
+        const Shader* shader {nullptr};  // Of the material
+        int index_count {0};
+        std::uint32_t matrix {0};  // Index of the renderable and of its model matrix
+        std::uint32_t instance {0};  // Index of the model matrix in the instance matrices
+    };
+
+    /*
+        The renderables of a frame turned into draw packets and sorted by a key, so that consecutive draws share as
+        much state as possible. From the most significant bits, the key is made of:
+
+        pass           2 bits
+        shader        12 bits
+        material      14 bits
+        vertex array  12 bits
+        depth         24 bits, front to back
+
+        Shaders, materials and vertex arrays are numbered in the order they are first seen in a frame. If there are
+        more than fit, the rest share the last number, which only makes the order worse, not the drawing wrong.
+
+        The model matrices are also laid out in the order of the sorted packets, so that consecutive packets of the
+        same material and vertex array can be drawn as instances of one draw call.
+    */
+    class RenderQueue {
+    public:
+        struct Packets {
+            const DrawPacket* begin() const { return first; }
+            const DrawPacket* end() const { return last; }
+
+            const DrawPacket* first {nullptr};
+            const DrawPacket* last {nullptr};
+        };
+
+        RenderQueue() = default;
+        ~RenderQueue() = default;
+
+        RenderQueue(const RenderQueue&) = delete;
+        RenderQueue& operator=(const RenderQueue&) = delete;
+        RenderQueue(RenderQueue&&) = delete;
+        RenderQueue& operator=(RenderQueue&&) = delete;
+
+        // Outline renderables are left out; the model matrices are in the order of the renderables and the view
+        // matrix is for the depth
+        void build(
+            const std::vector<Renderable>& renderables,
+            const std::vector<glm::mat4>& matrices,
+            const glm::mat4& view_matrix
+        );
+        void clear();
+
+        // Sorted, in the order to be drawn
+        Packets get_packets(RenderPass pass) const;
+
+        // One for every sorted packet, to be uploaded into the instance buffer
+        const std::vector<glm::mat4>& get_instance_matrices() const { return instance_matrices; }
+    private:
+        struct SortItem {
+            std::uint64_t key {0};
+            std::uint32_t packet {0};
+        };
+
+        static std::uint64_t number(
+            const void* resource,
+            std::unordered_map<const void*, std::uint64_t>& numbers,
+            std::uint64_t max
+        );
+
+        void sort(const std::vector<glm::mat4>& matrices);
+
+        static constexpr std::size_t PASSES {2};
+
+        std::vector<DrawPacket> packets;
+        std::vector<DrawPacket> sorted_packets;
+        std::vector<glm::mat4> instance_matrices;
+        std::size_t pass_begin[PASSES + 1] {};
+
+        // Reused every frame
+        std::vector<SortItem> items;
+        std::vector<SortItem> scratch;
+        std::unordered_map<const void*, std::uint64_t> shader_numbers;
+        std::unordered_map<const void*, std::uint64_t> material_numbers;
+        std::unordered_map<const void*, std::uint64_t> vertex_array_numbers;
+    };
+}
@@ -24,6 +24,9 @@
 #include "engine/renderable.hpp"
 #include "engine/light.hpp"
 #include "engine/font.hpp"
+#include "engine/profiler.hpp"
+#include "engine/render_queue.hpp"
+#include "engine/transform_stage.hpp"
 
 using namespace resmanager::literals;
 
@@ -120,6 +123,11 @@ namespace bb {
             VertexArray::unbind();
         }
 
+        {
+            // Model matrices of the renderables in the order they are drawn, streamed every frame
+            storage.instance_buffer = std::make_shared<VertexBuffer>(DrawHint::Stream);
+        }
+
         {
             // Doesn't have uniform buffers for sure
             storage.screen_quad_shader = std::make_unique<Shader>("data/shaders/screen_quad.vert", "data/shaders/screen_quad.frag");
@@ -142,6 +150,7 @@ namespace bb {
         }
 
         debug_initialize();
+        overlay_initialize();
     }
 
     Renderer::~Renderer() {
@@ -193,6 +202,16 @@ namespace bb {
         scene_list.renderables.push_back(renderable);
     }
 
+    void Renderer::add_renderables(const entt::registry& registry) {
+        const auto view {registry.view<const Renderable>()};
+
+        scene_list.renderables.reserve(scene_list.renderables.size() + view.size());
+
+        for (const entt::entity entity : view) {
+            scene_list.renderables.push_back(view.get<const Renderable>(entity));
+        }
+    }
+
     void Renderer::add_light(const DirectionalLight& light) {
         scene_list.directional_light = light;
     }
@@ -282,9 +301,36 @@ namespace bb {
         }
     }
 
+    void Renderer::overlay_add_text(const Text& text) {
+        // The texts of the previous frames are overwritten, so that their strings don't allocate every frame
+        if (overlay_scene_list.string_count < overlay_scene_list.strings.size()) {
+            overlay_scene_list.strings[overlay_scene_list.string_count] = text;
+        } else {
+            overlay_scene_list.strings.push_back(text);
+        }
+
+        overlay_scene_list.string_count++;
+    }
+
+    void Renderer::overlay_add_line(const glm::vec2& p1, const glm::vec2& p2, const glm::vec3& color) {
+        Line line;
+        line.p1 = glm::vec3(p1, 0.0f);
+        line.p2 = glm::vec3(p2, 0.0f);
+        line.color = color;
+
+        overlay_scene_list.lines.push_back(line);
+    }
+
     void Renderer::render() {
+        BB_PROFILE_SCOPE("Renderer::render");
+
         // TODO pre-render setup
 
+        gpu_timer.begin_frame();
+
+        // All the model matrices at once, shared by both passes
+        transform_stage.compute(scene_list.renderables);
+
         {
             auto uniform_buffer {storage.projection_view_uniform_buffer.lock()};
 
@@ -337,6 +383,21 @@ namespace bb {
 
         UniformBuffer::unbind();
 
+        // Both passes draw from the same sorted packets
+        render_queue.build(scene_list.renderables, transform_stage.get_matrices(), camera.view_matrix);
+
+        {
+            const std::vector<glm::mat4>& matrices {render_queue.get_instance_matrices()};
+
+            if (!matrices.empty()) {
+                storage.instance_buffer->bind();
+                storage.instance_buffer->upload_data(matrices.data(), matrices.size() * sizeof(glm::mat4));
+                VertexBuffer::unbind();
+            }
+        }
+
+        gpu_timer.begin_pass("shadow pass");
+
         storage.shadow_map_framebuffer->bind();
 
         OpenGl::clear(OpenGl::Buffers::D);
@@ -347,6 +408,9 @@ namespace bb {
 
         draw_renderables_to_depth_buffer();
 
+        gpu_timer.end_pass();
+        gpu_timer.begin_pass("scene pass");
+
         storage.scene_framebuffer->bind();
 
         OpenGl::clear(OpenGl::Buffers::CD);
@@ -359,10 +423,16 @@ namespace bb {
 
         draw_renderables();
 
+        gpu_timer.end_pass();
+
         if (storage.skybox_texture != nullptr) {
+            gpu_timer.begin_pass("skybox");
             draw_skybox();
+            gpu_timer.end_pass();
         }
 
+        gpu_timer.begin_pass("resolve");
+
         // Blit the resulted scene texture to an intermediate texture, resolving anti-aliasing
         storage.scene_framebuffer->blit(
             storage.intermediate_framebuffer.get(),
@@ -377,16 +447,33 @@ namespace bb {
             storage.intermediate_framebuffer->get_specification().height
         );
 
+        gpu_timer.end_pass();
+        gpu_timer.begin_pass("screen quad");
+
         // Do post processing and render the final 3D image to the screen
         end_rendering();
 
+        gpu_timer.end_pass();
+        gpu_timer.begin_pass("text");
+
         // Render 2D stuff
         draw_strings();
 
+        gpu_timer.end_pass();
+
         scene_list.clear();
 
+        gpu_timer.begin_pass("debug lines");
         debug_render();
+        gpu_timer.end_pass();
+
         debug_clear();
+
+        gpu_timer.begin_pass("overlay");
+        overlay_render();
+        gpu_timer.end_pass();
+
+        gpu_timer.end_frame();
     }
 
     void Renderer::prerender_setup() {
@@ -469,6 +556,8 @@ namespace bb {
     }
 
     void Renderer::end_rendering() {
+        BB_PROFILE_SCOPE("Renderer::end_rendering");
+
         storage.screen_quad_vertex_array->bind();
 
         OpenGl::disable_depth_test();
@@ -490,86 +579,131 @@ namespace bb {
     }
 
     void Renderer::draw_renderables() {
-        for (const Renderable& renderable : scene_list.renderables) {
-            auto material {renderable.material.lock()};
+        BB_PROFILE_SCOPE("Renderer::draw_renderables");
 
-            if (material->flags & Material::Outline) {
-                continue;  // This one is rendered differently
-            }
+        const Shader* bound_shader {nullptr};
+        const MaterialInstance* bound_material {nullptr};
+        const VertexArray* bound_vertex_array {nullptr};
+        bool back_face_culling {true};
 
-            if (material->flags & Material::DisableBackFaceCulling) {
-                OpenGl::disable_back_face_culling();
-            }
+        const RenderQueue::Packets packets {render_queue.get_packets(RenderPass::Scene)};
 
-            draw_renderable(renderable);
+        // Only what differs from the previous packet is set
+        for (const DrawPacket* packet {packets.begin()}; packet != packets.end();) {
+            if (packet->material != bound_material) {
+                if (packet->shader != bound_shader) {
+                    packet->shader->bind();
+                    bound_shader = packet->shader;
+                }
+
+                packet->material->upload();
+                bound_material = packet->material;
+
+                const bool culling {(packet->material->flags & Material::DisableBackFaceCulling) == 0};
+
+                if (culling != back_face_culling) {
+                    if (culling) {
+                        OpenGl::enable_back_face_culling();
+                    } else {
+                        OpenGl::disable_back_face_culling();
+                    }
 
-            if (material->flags & Material::DisableBackFaceCulling) {
-                OpenGl::enable_back_face_culling();
+                    back_face_culling = culling;
+                }
             }
-        }
 
-        VertexArray::unbind();  // Don't unbind for every renderable
-    }
+            const DrawPacket* run_end {packet + 1};
 
-    void Renderer::draw_renderable(const Renderable& renderable) {
-        auto vertex_array {renderable.vertex_array.lock()};
-        auto material {renderable.material.lock()};
+            if (packet->shader->is_instanced()) {
+                while (
+                    run_end != packets.end() &&
+                    run_end->material == packet->material &&
+                    run_end->vertex_array == packet->vertex_array
+                ) {
+                    run_end++;
+                }
+            }
 
-        glm::mat4 matrix;
+            draw_packets(packet, run_end, bound_vertex_array);
 
-        if (renderable.transformation) {
-            matrix = *renderable.transformation;
-        } else {
-            matrix = glm::mat4(1.0f);
-            matrix = glm::translate(matrix, renderable.position);
-            matrix = glm::rotate(matrix, renderable.rotation.x, glm::vec3(1.0f, 0.0f, 0.0f));
-            matrix = glm::rotate(matrix, renderable.rotation.y, glm::vec3(0.0f, 1.0f, 0.0f));
-            matrix = glm::rotate(matrix, renderable.rotation.z, glm::vec3(0.0f, 0.0f, 1.0f));
-            matrix = glm::scale(matrix, glm::vec3(renderable.scale));
+            packet = run_end;
         }
 
-        vertex_array->bind();
-        material->bind_and_upload();
-
-        material->get_shader()->upload_uniform_mat4("u_model_matrix"_H, matrix);
+        if (!back_face_culling) {
+            OpenGl::enable_back_face_culling();
+        }
 
-        OpenGl::draw_elements(vertex_array->get_index_buffer()->get_index_count());
+        VertexArray::unbind();  // Don't unbind for every renderable
     }
 
     void Renderer::draw_renderables_to_depth_buffer() {
+        BB_PROFILE_SCOPE("Renderer::draw_renderables_to_depth_buffer");
+
         storage.shadow_shader->bind();
 
-        for (const Renderable& renderable : scene_list.renderables) {
-            auto vertex_array {renderable.vertex_array.lock()};
-            auto material {renderable.material.lock()};
-
-            if (material->flags & Material::CastShadow) {
-                glm::mat4 matrix;
-
-                if (renderable.transformation) {
-                    matrix = *renderable.transformation;
-                } else {
-                    matrix = glm::mat4(1.0f);
-                    matrix = glm::translate(matrix, renderable.position);
-                    matrix = glm::rotate(matrix, renderable.rotation.x, glm::vec3(1.0f, 0.0f, 0.0f));
-                    matrix = glm::rotate(matrix, renderable.rotation.y, glm::vec3(0.0f, 1.0f, 0.0f));
-                    matrix = glm::rotate(matrix, renderable.rotation.z, glm::vec3(0.0f, 0.0f, 1.0f));
-                    matrix = glm::scale(matrix, glm::vec3(renderable.scale));
-                }
+        const VertexArray* bound_vertex_array {nullptr};
 
-                storage.shadow_shader->upload_uniform_mat4("u_model_matrix"_H, matrix);
+        const RenderQueue::Packets packets {render_queue.get_packets(RenderPass::Shadow)};
 
-                vertex_array->bind();
+        for (const DrawPacket* packet {packets.begin()}; packet != packets.end();) {
+            const DrawPacket* run_end {packet + 1};
 
-                OpenGl::draw_elements(vertex_array->get_index_buffer()->get_index_count());
+            // Every renderable is drawn with the same shader here, so only the vertex arrays differ
+            if (storage.shadow_shader->is_instanced()) {
+                while (run_end != packets.end() && run_end->vertex_array == packet->vertex_array) {
+                    run_end++;
+                }
             }
+
+            draw_packets(packet, run_end, bound_vertex_array, storage.shadow_shader.get());
+
+            packet = run_end;
         }
 
         // Don't unbind for every renderable
         VertexArray::unbind();
     }
 
+    void Renderer::draw_packets(
+        const DrawPacket* first,
+        const DrawPacket* last,
+        const VertexArray*& bound_vertex_array,
+        const Shader* shader
+    ) {
+        if (shader == nullptr) {
+            shader = first->shader;
+        }
+
+        VertexArray* vertex_array {first->vertex_array};
+
+        // The vertex array may have been bound already by a shader that isn't instanced
+        if (shader->is_instanced() && !vertex_array->has_instance_buffer()) {
+            vertex_array->add_instance_buffer(storage.instance_buffer);
+            bound_vertex_array = nullptr;  // Adding the buffer leaves no vertex array bound
+        }
+
+        if (vertex_array != bound_vertex_array) {
+            vertex_array->bind();
+            bound_vertex_array = vertex_array;
+        }
+
+        if (shader->is_instanced()) {
+            // The model matrices are already in the instance buffer, one after the other
+            OpenGl::draw_elements_instanced(first->index_count, static_cast<int>(last - first), first->instance);
+        } else {
+            const std::vector<glm::mat4>& matrices {render_queue.get_instance_matrices()};
+
+            for (const DrawPacket* packet {first}; packet != last; packet++) {
+                shader->upload_uniform_mat4("u_model_matrix"_H, matrices[packet->instance]);
+
+                OpenGl::draw_elements(packet->index_count);
+            }
+        }
+    }
+
     void Renderer::draw_skybox() {
+        BB_PROFILE_SCOPE("Renderer::draw_skybox");
+
         const glm::mat4& projection {camera.projection_matrix};
         const glm::mat4 view {glm::mat4(glm::mat3(camera.view_matrix))};
 
@@ -585,12 +719,14 @@ namespace bb {
     }
 
     void Renderer::draw_strings() {
+        BB_PROFILE_SCOPE("Renderer::draw_strings");
+
         storage.text_shader->bind();
 
         OpenGl::disable_depth_test();
 
         for (const auto& text : scene_list.strings) {
-            draw_string(text);
+            draw_string(text, camera_2d.projection_matrix);
         }
 
         OpenGl::enable_depth_test();
@@ -598,7 +734,7 @@ namespace bb {
         VertexArray::unbind();
     }
 
-    void Renderer::draw_string(const Text& text) {
+    void Renderer::draw_string(const Text& text, const glm::mat4& projection_matrix) {
         static std::vector<float> buffer;
         buffer.clear();
 
@@ -611,7 +747,7 @@ namespace bb {
 
         storage.text_shader->upload_uniform_mat4("u_model_matrix"_H, matrix);
         storage.text_shader->upload_uniform_vec3("u_color"_H, text.color);
-        storage.text_shader->upload_uniform_mat4("u_projection_matrix"_H, camera_2d.projection_matrix);
+        storage.text_shader->upload_uniform_mat4("u_projection_matrix"_H, projection_matrix);
 
         const float border_width = text.shadows ? 0.3f : 0.0f;
         const float offset = text.shadows ? -0.003f : 0.0f;
@@ -705,10 +841,28 @@ namespace bb {
     }
 
     void Renderer::debug_render() {
+        BB_PROFILE_SCOPE("Renderer::debug_render");
+
+        if (debug_scene_list.empty()) {
+            return;
+        }
+
+        debug_storage.shader->bind();
+
+        draw_lines(debug_scene_list, debug_storage.vertex_buffer.lock().get(), debug_storage.vertex_array.get());
+
+        debug_scene_list.clear();
+    }
+
+    void Renderer::debug_clear() {
+        debug_scene_list.clear();
+    }
+
+    void Renderer::draw_lines(const std::vector<Line>& lines, VertexBuffer* vertex_buffer, const VertexArray* vertex_array) {
         static std::vector<BufferVertexStruct> buffer;
         buffer.clear();
 
-        for (const Line& line : debug_scene_list) {
+        for (const Line& line : lines) {
             BufferVertexStruct v1;
             v1.position = line.p1;
             v1.color = line.color;
@@ -722,27 +876,71 @@ namespace bb {
             buffer.push_back(v2);
         }
 
-        if (buffer.empty()) {
-            return;
-        }
-
-        auto vertex_buffer {debug_storage.vertex_buffer.lock()};
-
         vertex_buffer->bind();
         vertex_buffer->upload_data(buffer.data(), buffer.size() * sizeof(BufferVertexStruct));
         VertexBuffer::unbind();
 
-        debug_storage.shader->bind();
-        debug_storage.vertex_array->bind();
+        vertex_array->bind();
 
-        OpenGl::draw_arrays_lines(debug_scene_list.size() * 2);
+        OpenGl::draw_arrays_lines(static_cast<int>(buffer.size()));
 
         VertexArray::unbind();
+    }
 
-        debug_scene_list.clear();
+    void Renderer::overlay_initialize() {
+        // Doesn't have uniform buffers, as it has its own projection
+        overlay_storage.shader = std::make_unique<Shader>("data/shaders/overlay.vert", "data/shaders/debug.frag");
+
+        auto vertex_buffer {std::make_shared<VertexBuffer>(DrawHint::Stream)};
+        overlay_storage.vertex_buffer = vertex_buffer;
+
+        VertexBufferLayout layout;
+        layout.add(0, VertexBufferLayout::Float, 3);
+        layout.add(1, VertexBufferLayout::Float, 3);
+
+        overlay_storage.vertex_array = std::make_unique<VertexArray>();
+        overlay_storage.vertex_array->bind();
+        overlay_storage.vertex_array->add_vertex_buffer(vertex_buffer, layout);
+        VertexArray::unbind();
     }
 
-    void Renderer::debug_clear() {
-        debug_scene_list.clear();
+    void Renderer::overlay_render() {
+        BB_PROFILE_SCOPE("Renderer::overlay_render");
+
+        if (overlay_scene_list.lines.empty() && overlay_scene_list.string_count == 0) {
+            return;
+        }
+
+        // The overlay is in pixels of the whole window, independent of the cameras of the scene
+        const glm::mat4 projection_matrix {glm::ortho(
+            0.0f,
+            static_cast<float>(storage.intermediate_framebuffer->get_specification().width),
+            0.0f,
+            static_cast<float>(storage.intermediate_framebuffer->get_specification().height)
+        )};
+
+        OpenGl::disable_depth_test();
+
+        if (!overlay_scene_list.lines.empty()) {
+            overlay_storage.shader->bind();
+            overlay_storage.shader->upload_uniform_mat4("u_projection_matrix"_H, projection_matrix);
+
+            draw_lines(overlay_scene_list.lines, overlay_storage.vertex_buffer.lock().get(), overlay_storage.vertex_array.get());
+        }
+
+        if (overlay_scene_list.string_count > 0) {
+            storage.text_shader->bind();
+
+            for (std::size_t i {0}; i < overlay_scene_list.string_count; i++) {
+                draw_string(overlay_scene_list.strings[i], projection_matrix);
+            }
+
+            VertexArray::unbind();
+        }
+
+        OpenGl::enable_depth_test();
+
+        overlay_scene_list.string_count = 0;
+        overlay_scene_list.lines.clear();
     }
 }
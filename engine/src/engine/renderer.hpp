@@ -3,12 +3,17 @@
 #include <vector>
 #include <memory>
 #include <unordered_map>
+#include <cstddef>
 
+#include <entt/entity/registry.hpp>
 #include <glm/glm.hpp>
 
 #include "engine/post_processing.hpp"
 #include "engine/renderable.hpp"
 #include "engine/light.hpp"
+#include "engine/gpu_timer.hpp"
+#include "engine/render_queue.hpp"
+#include "engine/transform_stage.hpp"
 
 namespace bb {
     class Application;
@@ -49,6 +54,7 @@ namespace bb {
 
         // 3D API
         void add_renderable(const Renderable& renderable);
+        void add_renderables(const entt::registry& registry);
         void add_light(const DirectionalLight& light);
         void add_light(const PointLight& light);
 
@@ -61,6 +67,14 @@ namespace bb {
 
         void debug_add_point(const glm::vec3& p, const glm::vec3& color);
         void debug_add_lamp(const glm::vec3& position, const glm::vec3& color);
+
+        // Overlay API, in pixels from the bottom left corner, drawn over everything else
+        void overlay_add_text(const Text& text);
+        void overlay_add_line(const glm::vec2& p1, const glm::vec2& p2, const glm::vec3& color);
+
+        // Timings of the render passes on the GPU, a few frames late; always on while profiling
+        void set_gpu_timing(bool enabled) { gpu_timer.set_enabled(enabled); }
+        const std::vector<GpuPassTime>& get_gpu_pass_times() const { return gpu_timer.get_pass_times(); }
     private:
         void render();
         void prerender_setup();
@@ -75,13 +89,20 @@ namespace bb {
 
         // Draw functions
         void draw_renderables();
-        void draw_renderable(const Renderable& renderable);
+
+        // Packets of the same vertex array, as instances, if the shader supports it; the material's shader by default
+        void draw_packets(
+            const DrawPacket* first,
+            const DrawPacket* last,
+            const VertexArray*& bound_vertex_array,
+            const Shader* shader = nullptr
+        );
 
         void draw_renderables_to_depth_buffer();
         void draw_skybox();
 
         void draw_strings();
-        void draw_string(const Text& text);
+        void draw_string(const Text& text, const glm::mat4& projection_matrix);
 
         // Helper functions
         void setup_point_light_uniform_buffer(std::shared_ptr<UniformBuffer> uniform_buffer);
@@ -100,6 +121,8 @@ namespace bb {
             std::unique_ptr<VertexArray> screen_quad_vertex_array;
             std::shared_ptr<VertexArray> skybox_vertex_array;
 
+            std::shared_ptr<VertexBuffer> instance_buffer;
+
             std::shared_ptr<TextureCubemap> skybox_texture;
 
             std::unordered_map<unsigned int, std::weak_ptr<UniformBuffer>> uniform_buffers;
@@ -142,6 +165,10 @@ namespace bb {
             void clear();
         } scene_list;
 
+        // The renderables of the scene list, sorted to change as little state as possible between draws
+        TransformStage transform_stage;
+        RenderQueue render_queue;
+
         struct {
             std::vector<std::weak_ptr<Shader>> shaders;
             std::vector<std::weak_ptr<Framebuffer>> framebuffers;
@@ -172,6 +199,28 @@ namespace bb {
 
         std::vector<Line> debug_scene_list;
 
+        void draw_lines(const std::vector<Line>& lines, VertexBuffer* vertex_buffer, const VertexArray* vertex_array);
+
+        // Overlay stuff
+        void overlay_initialize();
+        void overlay_render();
+
+        struct {
+            std::unique_ptr<Shader> shader;
+
+            std::weak_ptr<VertexBuffer> vertex_buffer;
+            std::unique_ptr<VertexArray> vertex_array;
+        } overlay_storage;
+
+        struct {
+            std::vector<Text> strings;  // Only the first string_count are of this frame
+            std::size_t string_count {0};
+            std::vector<Line> lines;
+        } overlay_scene_list;
+
+        GpuTimer gpu_timer;
+
         friend class Application;
+        friend class RenderCapture;
     };
 }
@@ -27,10 +27,31 @@ namespace bb {
         return application->dt;
     }
 
+    float Scene::get_fixed_delta() const {
+        return static_cast<float>(application->fixed_dt);
+    }
+
+    float Scene::get_interpolation_alpha() const {
+        return application->alpha;
+    }
+
     double Scene::get_fps() const {
         return application->fps;
     }
 
+    const FrameStatistics& Scene::get_frame_statistics() const {
+        return application->frame_statistics;
+    }
+
+    void Scene::set_performance_overlay_font(std::shared_ptr<Font> font) {
+        application->performance_overlay.set_font(font);
+    }
+
+    void Scene::show_performance_overlay(bool visible) {
+        application->performance_overlay.set_visible(visible);
+        application->renderer->set_gpu_timing(visible);
+    }
+
     void Scene::set_vsync(bool enabled) {
         application->window->set_vsync(enabled);
     }
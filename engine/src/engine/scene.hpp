@@ -4,11 +4,13 @@
 #include <utility>
 #include <vector>
 
+#include <entt/entity/registry.hpp>
 #include <glm/glm.hpp>
 
 #include "engine/application.hpp"
 #include "engine/events.hpp"
 #include "engine/sound_data.hpp"
+#include "engine/random.hpp"
 
 namespace bb {
     struct Camera;
@@ -20,6 +22,7 @@ namespace bb {
     struct PointLight;
     class Shader;
     class TextureCubemap;
+    class Font;
 
     class Scene {
     public:
@@ -36,15 +39,27 @@ namespace bb {
         virtual void on_enter() {}
         virtual void on_exit() {}
         virtual void on_update() {}
+        virtual void on_fixed_update() {}
 
         const std::string& get_name() const { return name; }
     protected:
+        // Entities with a Renderable component are rendered every frame
+        entt::registry& get_registry() { return registry; }
+
+        // Seeded by the application, so that replays are reproducible
+        Random& get_random() { return random; }
+
         void change_scene(const std::string& scene_name);
         void quit_application();
         int get_width() const;
         int get_height() const;
         float get_delta() const;
+        float get_fixed_delta() const;
+        float get_interpolation_alpha() const;
         double get_fps() const;
+        const FrameStatistics& get_frame_statistics() const;
+        void set_performance_overlay_font(std::shared_ptr<Font> font);
+        void show_performance_overlay(bool visible);
         void set_vsync(bool enabled);
         void capture_mouse(bool enabled);
 
@@ -111,6 +126,9 @@ namespace bb {
         std::string name;
         Application* application {nullptr};
 
+        entt::registry registry;
+        Random random;
+
         friend class Application;
     };
 }
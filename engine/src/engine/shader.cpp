@@ -21,15 +21,17 @@
 #include "engine/shader.hpp"
 #include "engine/buffer.hpp"
 #include "engine/logging.hpp"
+#include "engine/frame_counters.hpp"
 
 namespace bb {
-    Shader::Shader(const std::string& source_vertex, const std::string& source_fragment) {
+    Shader::Shader(const std::string& source_vertex, const std::string& source_fragment)
+        : source_vertex_path(source_vertex), source_fragment_path(source_fragment) {
         vertex_shader = compile_shader(source_vertex, GL_VERTEX_SHADER);
         fragment_shader = compile_shader(source_fragment, GL_FRAGMENT_SHADER);
         program = create_program();
 
         if (!check_linking(program)) {
-            log_message("Could not link shader program %d\n", program);
+            BB_LOG_ERROR(Resources, "Could not link shader program %d\n", program);
             throw ResourceLoadingError;
         }
 
@@ -38,7 +40,8 @@ namespace bb {
         check_and_cache_uniforms();
     }
 
-    Shader::Shader(const std::string& source_vertex, const std::string& source_fragment, const std::string& includes) {
+    Shader::Shader(const std::string& source_vertex, const std::string& source_fragment, const std::string& includes)
+        : source_vertex_path(source_vertex), source_fragment_path(source_fragment), includes_path(includes) {
         char error[256] {};
         char* result_vertex {nullptr};
         char* result_fragment {nullptr};
@@ -52,7 +55,7 @@ namespace bb {
             );
 
             if (result_vertex == nullptr) {
-                log_message("Could not load the files of shader program %d: %s\n", program, error);
+                BB_LOG_ERROR(Resources, "Could not load the files of shader program %d: %s\n", program, error);
                 throw ResourceLoadingError;
             }
 
@@ -64,7 +67,7 @@ namespace bb {
             );
 
             if (result_fragment == nullptr) {
-                log_message("Could not load the files of shader program %d: %s\n", program, error);
+                BB_LOG_ERROR(Resources, "Could not load the files of shader program %d: %s\n", program, error);
                 throw ResourceLoadingError;
             }
 
@@ -79,7 +82,7 @@ namespace bb {
             program = create_program();
 
             if (!check_linking(program)) {
-                log_message("Could not link shader program %d\n", program);
+                BB_LOG_ERROR(Resources, "Could not link shader program %d\n", program);
                 throw ResourceLoadingError;
             }
 
@@ -101,6 +104,7 @@ namespace bb {
 
     void Shader::bind() const {
         glUseProgram(program);
+        FrameCounters::count_bind();
     }
 
     void Shader::unbind() {
@@ -163,7 +167,7 @@ namespace bb {
             location = glGetUniformLocation(program, uniform.c_str());
 
             if (location == -1) {
-                log_message("Uniform variable `%s` not found\n", uniform.c_str());
+                BB_LOG_WARNING(Resources, "Uniform variable `%s` not found\n", uniform.c_str());
                 continue;
             }
 
@@ -235,6 +239,9 @@ namespace bb {
 
             uniform_blocks.push_back(block);
         }
+
+        // Attributes stuff
+        instanced = glGetAttribLocation(program, "a_model_matrix") != -1;
     }
 
     unsigned int Shader::create_program() const {
@@ -268,7 +275,7 @@ namespace bb {
         std::ifstream file {source_path, std::ios::binary};
 
         if (!file.is_open()) {
-            log_message("Could not open file `%s` for reading\n", source_path.c_str());
+            BB_LOG_ERROR(Resources, "Could not open file `%s` for reading\n", source_path.c_str());
             throw ResourceLoadingError;
         }
 
@@ -290,7 +297,7 @@ namespace bb {
         delete[] buffer;
 
         if (!check_compilation(shader, type)) {
-            log_message("Could not compile shader %d\n", shader);
+            BB_LOG_ERROR(Resources, "Could not compile shader %d\n", shader);
             throw ResourceLoadingError;
         }
 
@@ -308,7 +315,7 @@ namespace bb {
         glCompileShader(shader);
 
         if (!check_compilation(shader, type)) {
-            log_message("Could not compile shader %d\n", shader);
+            BB_LOG_ERROR(Resources, "Could not compile shader %d\n", shader);
             throw ResourceLoadingError;
         }
 
@@ -337,12 +344,12 @@ namespace bb {
             }
 
             if (log_length == 0) {
-                log_message("%s shader compilation error with no message\n", type_name);
+                BB_LOG_ERROR(Resources, "%s shader compilation error with no message\n", type_name);
             } else {
                 char* message {new char[log_length]};
                 glGetShaderInfoLog(shader, log_length, nullptr, message);
 
-                log_message("%s shader compilation error\n%s\n", type_name, message);
+                BB_LOG_ERROR(Resources, "%s shader compilation error\n%s\n", type_name, message);
                 delete[] message;
             }
 
@@ -361,12 +368,12 @@ namespace bb {
             glGetProgramiv(program, GL_INFO_LOG_LENGTH, &log_length);
 
             if (log_length == 0) {
-                log_message("Linking error with no message\n");
+                BB_LOG_ERROR(Resources, "Linking error with no message\n");
             } else {
                 char* message {new char[log_length]};
                 glGetProgramInfoLog(program, log_length, nullptr, message);
 
-                log_message("Linking error\n%s\n", message);
+                BB_LOG_ERROR(Resources, "Linking error\n%s\n", message);
                 delete[] message;
             }
 
@@ -41,6 +41,9 @@ namespace bb {
 
         unsigned int get_id() const { return program; }
 
+        // The model matrix comes from the a_model_matrix attribute of every instance instead of u_model_matrix
+        bool is_instanced() const { return instanced; }
+
         void add_uniform_buffer(std::shared_ptr<UniformBuffer> uniform_buffer);
     private:
         int get_uniform_location(Key name) const;
@@ -65,10 +68,17 @@ namespace bb {
         // Data from introspection
         std::vector<std::string> uniforms;
         std::vector<UniformBlockSpecification> uniform_blocks;
+        bool instanced {false};
 
         // Shaders own uniform buffers
         std::vector<std::shared_ptr<UniformBuffer>> uniform_buffers;
 
+        // Where the sources came from, so that render captures can recreate the program
+        std::string source_vertex_path;
+        std::string source_fragment_path;
+        std::string includes_path;
+
         friend class Renderer;
+        friend class RenderCapture;
     };
 }
@@ -10,7 +10,7 @@ namespace bb {
         Mix_Chunk* chunk {Mix_LoadWAV(file_path.c_str())};
 
         if (chunk == nullptr) {
-            log_message("Could not load sound data `%s`\n", file_path.c_str());
+            BB_LOG_ERROR(Resources, "Could not load sound data `%s`\n", file_path.c_str());
             throw ResourceLoadingError;
         }
 
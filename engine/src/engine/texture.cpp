@@ -14,6 +14,7 @@
 
 #include "engine/texture_data.hpp"
 #include "engine/texture.hpp"
+#include "engine/frame_counters.hpp"
 #include "engine/panic.hpp"
 #include "engine/logging.hpp"
 
@@ -94,7 +95,7 @@ namespace bb {
         SDL_Surface* surface {IMG_Load(file_path.c_str())};
 
         if (surface == nullptr) {
-            log_message("Could not load texture `%s`\n", file_path.c_str());
+            BB_LOG_ERROR(Resources, "Could not load texture `%s`\n", file_path.c_str());
             throw ResourceLoadingError;
         }
 
@@ -164,16 +165,19 @@ namespace bb {
             case Format::Rgba8:
                 glTexStorage2D(GL_TEXTURE_2D, specification.mipmap_levels, GL_RGBA8, width, height);
                 glTexSubImage2D(GL_TEXTURE_2D, 0, 0, 0, width, height, GL_RGBA, GL_UNSIGNED_BYTE, data);
+                FrameCounters::count_upload(static_cast<std::size_t>(width * height * 4));
 
                 break;
             case Format::Rgb8:
                 glTexStorage2D(GL_TEXTURE_2D, specification.mipmap_levels, GL_RGB8, width, height);
                 glTexSubImage2D(GL_TEXTURE_2D, 0, 0, 0, width, height, GL_RGB, GL_UNSIGNED_BYTE, data);
+                FrameCounters::count_upload(static_cast<std::size_t>(width * height * 3));
 
                 break;
             case Format::R8:
                 glTexStorage2D(GL_TEXTURE_2D, specification.mipmap_levels, GL_R8, width, height);
                 glTexSubImage2D(GL_TEXTURE_2D, 0, 0, 0, width, height, GL_RED, GL_UNSIGNED_BYTE, data);
+                FrameCounters::count_upload(static_cast<std::size_t>(width * height * 1));
 
                 break;
         }
@@ -192,7 +196,7 @@ namespace bb {
             SDL_Surface* surface {IMG_Load(file_paths[i])};
 
             if (surface == nullptr) {
-                log_message("Could not load texture `%s`\n", file_paths[i]);
+                BB_LOG_ERROR(Resources, "Could not load texture `%s`\n", file_paths[i]);
                 throw ResourceLoadingError;
             }
 
@@ -210,6 +214,8 @@ namespace bb {
                 GL_RGBA, GL_UNSIGNED_BYTE, data[i]->pixels
             );
 
+            FrameCounters::count_upload(static_cast<std::size_t>(width * height * 4));
+
             SDL_FreeSurface(data[i]);
         }
 
@@ -229,6 +235,30 @@ namespace bb {
                 GL_TEXTURE_CUBE_MAP_POSITIVE_X + i, 0, 0, 0, data[i]->width, data[i]->height,
                 GL_RGBA, GL_UNSIGNED_BYTE, data[i]->get_data()
             );
+
+            FrameCounters::count_upload(static_cast<std::size_t>(data[i]->width * data[i]->height * 4));
+        }
+
+        glBindTexture(GL_TEXTURE_CUBE_MAP, 0);
+    }
+
+    TextureCubemap::TextureCubemap(int width, int height, const std::array<const unsigned char*, 6>& data) {
+        glGenTextures(1, &texture);
+        glBindTexture(GL_TEXTURE_CUBE_MAP, texture);
+
+        configure_filter_and_wrap_3d();
+
+        glTexStorage2D(GL_TEXTURE_CUBE_MAP, 1, GL_RGBA8, width, height);
+
+        for (std::size_t i {0}; i < 6; i++) {
+            assert(data[i] != nullptr);
+
+            glTexSubImage2D(
+                GL_TEXTURE_CUBE_MAP_POSITIVE_X + i, 0, 0, 0, width, height,
+                GL_RGBA, GL_UNSIGNED_BYTE, data[i]
+            );
+
+            FrameCounters::count_upload(static_cast<std::size_t>(width * height * 4));
         }
 
         glBindTexture(GL_TEXTURE_CUBE_MAP, 0);
@@ -76,6 +76,7 @@ namespace bb {
         // Textures need to be RGBA
         TextureCubemap(const char** file_paths);
         TextureCubemap(const std::array<std::shared_ptr<TextureData>, 6>& data);
+        TextureCubemap(int width, int height, const std::array<const unsigned char*, 6>& data);
         ~TextureCubemap();
 
         TextureCubemap(const TextureCubemap&) = delete;
@@ -83,6 +84,8 @@ namespace bb {
         TextureCubemap(TextureCubemap&&) = delete;
         TextureCubemap& operator=(TextureCubemap&&) = delete;
 
+        unsigned int get_id() const { return texture; }
+
         void bind(unsigned int unit) const;
         static void unbind();
     private:
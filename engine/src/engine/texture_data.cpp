@@ -11,7 +11,7 @@ namespace bb {
         SDL_Surface* surface {IMG_Load(file_path.c_str())};
 
         if (surface == nullptr) {
-            log_message("Could not load texture data `%s`\n", file_path.c_str());
+            BB_LOG_ERROR(Resources, "Could not load texture data `%s`\n", file_path.c_str());
             throw ResourceLoadingError;
         }
 
@@ -0,0 +1,253 @@
+#include <vector>
+#include <cstddef>
+#include <cstdint>
+#include <cmath>
+
+#if defined(__SSE2__) || defined(_M_X64)
+    #include <emmintrin.h>
+#endif
+
+#include <glm/glm.hpp>
+
+#include "engine/transform_stage.hpp"
+#include "engine/profiler.hpp"
+
+namespace bb {
+    // The same as translating, rotating in X, Y and Z and scaling, with the rotations multiplied out by hand
+    static void compose_matrix(
+        glm::mat4& matrix,
+        float position_x,
+        float position_y,
+        float position_z,
+        float rotation_x,
+        float rotation_y,
+        float rotation_z,
+        float scale
+    ) {
+        const float sin_x {std::sin(rotation_x)};
+        const float cos_x {std::cos(rotation_x)};
+        const float sin_y {std::sin(rotation_y)};
+        const float cos_y {std::cos(rotation_y)};
+        const float sin_z {std::sin(rotation_z)};
+        const float cos_z {std::cos(rotation_z)};
+
+        matrix[0][0] = cos_y * cos_z * scale;
+        matrix[0][1] = (sin_x * sin_y * cos_z + cos_x * sin_z) * scale;
+        matrix[0][2] = (sin_x * sin_z - cos_x * sin_y * cos_z) * scale;
+        matrix[0][3] = 0.0f;
+
+        matrix[1][0] = -cos_y * sin_z * scale;
+        matrix[1][1] = (cos_x * cos_z - sin_x * sin_y * sin_z) * scale;
+        matrix[1][2] = (cos_x * sin_y * sin_z + sin_x * cos_z) * scale;
+        matrix[1][3] = 0.0f;
+
+        matrix[2][0] = sin_y * scale;
+        matrix[2][1] = -sin_x * cos_y * scale;
+        matrix[2][2] = cos_x * cos_y * scale;
+        matrix[2][3] = 0.0f;
+
+        matrix[3][0] = position_x;
+        matrix[3][1] = position_y;
+        matrix[3][2] = position_z;
+        matrix[3][3] = 1.0f;
+    }
+
+#if defined(__SSE2__) || defined(_M_X64)
+    // Beyond this the reduction into [-pi/4, pi/4] loses precision, so such angles go through the standard library
+    static constexpr float MAX_ANGLE {8192.0f};
+
+    // The polynomials and the range reduction of the Cephes library's sinf and cosf
+    static void sin_cos(__m128 x, __m128& sin, __m128& cos) {
+        const __m128 sign_mask {_mm_castsi128_ps(_mm_set1_epi32(static_cast<int>(0x80000000u)))};
+
+        __m128 sign_sin {_mm_and_ps(x, sign_mask)};
+        x = _mm_andnot_ps(sign_mask, x);
+
+        // The octant, rounded up to an even one
+        __m128i octant {_mm_cvttps_epi32(_mm_mul_ps(x, _mm_set1_ps(1.27323954473516f)))};
+        octant = _mm_and_si128(_mm_add_epi32(octant, _mm_set1_epi32(1)), _mm_set1_epi32(~1));
+        const __m128 y {_mm_cvtepi32_ps(octant)};
+
+        sign_sin = _mm_xor_ps(sign_sin, _mm_castsi128_ps(_mm_slli_epi32(_mm_and_si128(octant, _mm_set1_epi32(4)), 29)));
+
+        const __m128 sign_cos {
+            _mm_castsi128_ps(
+                _mm_slli_epi32(_mm_andnot_si128(_mm_sub_epi32(octant, _mm_set1_epi32(2)), _mm_set1_epi32(4)), 29)
+            )
+        };
+
+        // In octants 2 and 6 the polynomials swap places
+        const __m128 polynomial_mask {
+            _mm_castsi128_ps(_mm_cmpeq_epi32(_mm_and_si128(octant, _mm_set1_epi32(2)), _mm_setzero_si128()))
+        };
+
+        // Pi / 4 in three parts, so that the reduction is exact enough
+        x = _mm_sub_ps(x, _mm_mul_ps(y, _mm_set1_ps(0.78515625f)));
+        x = _mm_sub_ps(x, _mm_mul_ps(y, _mm_set1_ps(2.4187564849853515625e-4f)));
+        x = _mm_sub_ps(x, _mm_mul_ps(y, _mm_set1_ps(3.77489497744594108e-8f)));
+
+        const __m128 z {_mm_mul_ps(x, x)};
+
+        __m128 cos_polynomial {_mm_set1_ps(2.443315711809948e-5f)};
+        cos_polynomial = _mm_add_ps(_mm_mul_ps(cos_polynomial, z), _mm_set1_ps(-1.388731625493765e-3f));
+        cos_polynomial = _mm_add_ps(_mm_mul_ps(cos_polynomial, z), _mm_set1_ps(4.166664568298827e-2f));
+        cos_polynomial = _mm_mul_ps(_mm_mul_ps(cos_polynomial, z), z);
+        cos_polynomial = _mm_sub_ps(cos_polynomial, _mm_mul_ps(z, _mm_set1_ps(0.5f)));
+        cos_polynomial = _mm_add_ps(cos_polynomial, _mm_set1_ps(1.0f));
+
+        __m128 sin_polynomial {_mm_set1_ps(-1.9515295891e-4f)};
+        sin_polynomial = _mm_add_ps(_mm_mul_ps(sin_polynomial, z), _mm_set1_ps(8.3321608736e-3f));
+        sin_polynomial = _mm_add_ps(_mm_mul_ps(sin_polynomial, z), _mm_set1_ps(-1.6666654611e-1f));
+        sin_polynomial = _mm_add_ps(_mm_mul_ps(_mm_mul_ps(sin_polynomial, z), x), x);
+
+        sin = _mm_or_ps(_mm_and_ps(polynomial_mask, sin_polynomial), _mm_andnot_ps(polynomial_mask, cos_polynomial));
+        cos = _mm_or_ps(_mm_and_ps(polynomial_mask, cos_polynomial), _mm_andnot_ps(polynomial_mask, sin_polynomial));
+
+        sin = _mm_xor_ps(sin, sign_sin);
+        cos = _mm_xor_ps(cos, sign_cos);
+    }
+
+    static bool small_angles(__m128 x, __m128 y, __m128 z) {
+        const __m128 sign_mask {_mm_castsi128_ps(_mm_set1_epi32(static_cast<int>(0x80000000u)))};
+        const __m128 max_angle {_mm_set1_ps(MAX_ANGLE)};
+
+        const __m128 small_x {_mm_cmple_ps(_mm_andnot_ps(sign_mask, x), max_angle)};
+        const __m128 small_y {_mm_cmple_ps(_mm_andnot_ps(sign_mask, y), max_angle)};
+        const __m128 small_z {_mm_cmple_ps(_mm_andnot_ps(sign_mask, z), max_angle)};
+
+        return _mm_movemask_ps(_mm_and_ps(_mm_and_ps(small_x, small_y), small_z)) == 0xF;
+    }
+#endif
+
+    void TransformStage::compute(const std::vector<Renderable>& renderables) {
+        BB_PROFILE_SCOPE("TransformStage::compute");
+
+        matrices.resize(renderables.size());
+
+        indices.clear();
+        position_x.clear();
+        position_y.clear();
+        position_z.clear();
+        rotation_x.clear();
+        rotation_y.clear();
+        rotation_z.clear();
+        scale.clear();
+
+        for (std::size_t i {0}; i < renderables.size(); i++) {
+            const Renderable& renderable {renderables[i]};
+
+            if (renderable.transformation) {
+                matrices[i] = *renderable.transformation;
+                continue;
+            }
+
+            indices.push_back(static_cast<std::uint32_t>(i));
+            position_x.push_back(renderable.position.x);
+            position_y.push_back(renderable.position.y);
+            position_z.push_back(renderable.position.z);
+            rotation_x.push_back(renderable.rotation.x);
+            rotation_y.push_back(renderable.rotation.y);
+            rotation_z.push_back(renderable.rotation.z);
+            scale.push_back(renderable.scale);
+        }
+
+        compose();
+    }
+
+    void TransformStage::compose() {
+        const std::size_t count {indices.size()};
+
+        std::size_t i {0};
+
+#if defined(__SSE2__) || defined(_M_X64)
+        for (; i + 4 <= count; i += 4) {
+            const __m128 angle_x {_mm_loadu_ps(&rotation_x[i])};
+            const __m128 angle_y {_mm_loadu_ps(&rotation_y[i])};
+            const __m128 angle_z {_mm_loadu_ps(&rotation_z[i])};
+
+            if (!small_angles(angle_x, angle_y, angle_z)) {
+                for (std::size_t j {i}; j < i + 4; j++) {
+                    compose_matrix(
+                        matrices[indices[j]],
+                        position_x[j],
+                        position_y[j],
+                        position_z[j],
+                        rotation_x[j],
+                        rotation_y[j],
+                        rotation_z[j],
+                        scale[j]
+                    );
+                }
+
+                continue;
+            }
+
+            __m128 sin_x, cos_x, sin_y, cos_y, sin_z, cos_z;
+            sin_cos(angle_x, sin_x, cos_x);
+            sin_cos(angle_y, sin_y, cos_y);
+            sin_cos(angle_z, sin_z, cos_z);
+
+            const __m128 s {_mm_loadu_ps(&scale[i])};
+            const __m128 sin_x_sin_y {_mm_mul_ps(sin_x, sin_y)};
+            const __m128 cos_x_sin_y {_mm_mul_ps(cos_x, sin_y)};
+
+            // Every register is one element of the four matrices
+            __m128 column0_x {_mm_mul_ps(_mm_mul_ps(cos_y, cos_z), s)};
+            __m128 column0_y {_mm_mul_ps(_mm_add_ps(_mm_mul_ps(sin_x_sin_y, cos_z), _mm_mul_ps(cos_x, sin_z)), s)};
+            __m128 column0_z {_mm_mul_ps(_mm_sub_ps(_mm_mul_ps(sin_x, sin_z), _mm_mul_ps(cos_x_sin_y, cos_z)), s)};
+            __m128 column0_w {_mm_setzero_ps()};
+
+            __m128 column1_x {_mm_sub_ps(_mm_setzero_ps(), _mm_mul_ps(_mm_mul_ps(cos_y, sin_z), s))};
+            __m128 column1_y {_mm_mul_ps(_mm_sub_ps(_mm_mul_ps(cos_x, cos_z), _mm_mul_ps(sin_x_sin_y, sin_z)), s)};
+            __m128 column1_z {_mm_mul_ps(_mm_add_ps(_mm_mul_ps(cos_x_sin_y, sin_z), _mm_mul_ps(sin_x, cos_z)), s)};
+            __m128 column1_w {_mm_setzero_ps()};
+
+            __m128 column2_x {_mm_mul_ps(sin_y, s)};
+            __m128 column2_y {_mm_sub_ps(_mm_setzero_ps(), _mm_mul_ps(_mm_mul_ps(sin_x, cos_y), s))};
+            __m128 column2_z {_mm_mul_ps(_mm_mul_ps(cos_x, cos_y), s)};
+            __m128 column2_w {_mm_setzero_ps()};
+
+            __m128 column3_x {_mm_loadu_ps(&position_x[i])};
+            __m128 column3_y {_mm_loadu_ps(&position_y[i])};
+            __m128 column3_z {_mm_loadu_ps(&position_z[i])};
+            __m128 column3_w {_mm_set1_ps(1.0f)};
+
+            // Now every register is one column of one matrix
+            _MM_TRANSPOSE4_PS(column0_x, column0_y, column0_z, column0_w);
+            _MM_TRANSPOSE4_PS(column1_x, column1_y, column1_z, column1_w);
+            _MM_TRANSPOSE4_PS(column2_x, column2_y, column2_z, column2_w);
+            _MM_TRANSPOSE4_PS(column3_x, column3_y, column3_z, column3_w);
+
+            const __m128 columns[4][4] {
+                { column0_x, column1_x, column2_x, column3_x },
+                { column0_y, column1_y, column2_y, column3_y },
+                { column0_z, column1_z, column2_z, column3_z },
+                { column0_w, column1_w, column2_w, column3_w }
+            };
+
+            for (std::size_t j {0}; j < 4; j++) {
+                float* matrix {&matrices[indices[i + j]][0][0]};
+
+                _mm_storeu_ps(matrix + 0, columns[j][0]);
+                _mm_storeu_ps(matrix + 4, columns[j][1]);
+                _mm_storeu_ps(matrix + 8, columns[j][2]);
+                _mm_storeu_ps(matrix + 12, columns[j][3]);
+            }
+        }
+#endif
+
+        // The remaining renderables, or all of them without SIMD
+        for (; i < count; i++) {
+            compose_matrix(
+                matrices[indices[i]],
+                position_x[i],
+                position_y[i],
+                position_z[i],
+                rotation_x[i],
+                rotation_y[i],
+                rotation_z[i],
+                scale[i]
+            );
+        }
+    }
+}
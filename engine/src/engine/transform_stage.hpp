@@ -0,0 +1,46 @@
+#pragma once
+
+#include <vector>
+#include <cstdint>
+
+#include <glm/glm.hpp>
+
+#include "engine/renderable.hpp"
+
+namespace bb {
+    /*
+        Computes the model matrices of all the renderables of a frame in one go, into one contiguous array that
+        both the shadow and the scene passes index. The rotations in X, Y and Z order are composed directly from
+        their sines and cosines, four renderables at a time with SSE2. Renderables that have their own
+        transformation just have it copied.
+    */
+    class TransformStage {
+    public:
+        TransformStage() = default;
+        ~TransformStage() = default;
+
+        TransformStage(const TransformStage&) = delete;
+        TransformStage& operator=(const TransformStage&) = delete;
+        TransformStage(TransformStage&&) = delete;
+        TransformStage& operator=(TransformStage&&) = delete;
+
+        void compute(const std::vector<Renderable>& renderables);
+
+        // In the order of the renderables
+        const std::vector<glm::mat4>& get_matrices() const { return matrices; }
+    private:
+        void compose();
+
+        std::vector<glm::mat4> matrices;
+
+        // Of the renderables without a transformation, as structure of arrays; reused every frame
+        std::vector<std::uint32_t> indices;
+        std::vector<float> position_x;
+        std::vector<float> position_y;
+        std::vector<float> position_z;
+        std::vector<float> rotation_x;
+        std::vector<float> rotation_y;
+        std::vector<float> rotation_z;
+        std::vector<float> scale;
+    };
+}
@@ -10,6 +10,7 @@
 #include "engine/vertex_array.hpp"
 #include "engine/buffer.hpp"
 #include "engine/vertex_buffer_layout.hpp"
+#include "engine/frame_counters.hpp"
 #include "engine/logging.hpp"
 
 namespace bb {
@@ -26,6 +27,7 @@ namespace bb {
 
     void VertexArray::bind() const {
         glBindVertexArray(array);
+        FrameCounters::count_bind();
     }
 
     void VertexArray::unbind() {
@@ -83,6 +85,7 @@ namespace bb {
         }
 
         vertex_buffers.push_back(buffer);
+        layouts.push_back(layout);
 
         VertexBuffer::unbind();
     }
@@ -92,4 +95,31 @@ namespace bb {
 
         index_buffer = buffer;
     }
+
+    void VertexArray::add_instance_buffer(std::shared_ptr<VertexBuffer> buffer) {
+        static constexpr unsigned int LOCATION {8};
+        static constexpr std::size_t COLUMN_SIZE {sizeof(float) * 4};
+
+        bind();
+        buffer->bind();
+
+        // A matrix takes four attributes, one for every column
+        for (unsigned int i {0}; i < 4; i++) {
+            glVertexAttribPointer(
+                LOCATION + i,
+                4,
+                GL_FLOAT,
+                GL_FALSE,
+                static_cast<int>(COLUMN_SIZE * 4),
+                reinterpret_cast<void*>(COLUMN_SIZE * i)
+            );
+            glEnableVertexAttribArray(LOCATION + i);
+            glVertexAttribDivisor(LOCATION + i, 1);
+        }
+
+        instance_buffer = buffer;
+
+        unbind();
+        VertexBuffer::unbind();
+    }
 }
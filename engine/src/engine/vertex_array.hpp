@@ -30,11 +30,19 @@ namespace bb {
         void add_vertex_buffer(std::shared_ptr<VertexBuffer> buffer, const VertexBufferLayout& layout);
         void add_index_buffer(std::shared_ptr<IndexBuffer> buffer);
 
+        // Model matrices per instance, at locations 8 to 11, for instanced shaders; the renderer adds this one
+        void add_instance_buffer(std::shared_ptr<VertexBuffer> buffer);
+        bool has_instance_buffer() const { return instance_buffer != nullptr; }
+
         const IndexBuffer* get_index_buffer() const { return index_buffer.get(); }
     private:
         unsigned int array {0};
 
         std::vector<std::shared_ptr<VertexBuffer>> vertex_buffers;
+        std::vector<VertexBufferLayout> layouts;  // Of every vertex buffer
         std::shared_ptr<IndexBuffer> index_buffer;
+        std::shared_ptr<VertexBuffer> instance_buffer;  // Not part of the mesh
+
+        friend class RenderCapture;
     };
 }
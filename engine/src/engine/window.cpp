@@ -1,4 +1,8 @@
 #include <string>
+#include <vector>
+#include <memory>
+#include <cstddef>
+#include <cstring>
 
 #ifdef BB_CHRONO_TIMER
     #include <chrono>
@@ -6,8 +10,15 @@
 
 #include <glad/glad.h>
 #include <SDL.h>
+#include <SDL_image.h>
+
+#ifdef BB_HEADLESS
+    #include <EGL/egl.h>
+    #include <EGL/eglext.h>
+#endif
 
 #include "engine/window.hpp"
+#include "engine/framebuffer.hpp"
 #include "engine/panic.hpp"
 #include "engine/logging.hpp"
 #include "engine/application.hpp"
@@ -15,9 +26,40 @@
 
 namespace bb {
     Window::Window(const WindowProperties& properties, Application* application)
-        : width(properties.width), height(properties.height), application(application) {
+        : width(properties.width), height(properties.height), headless(properties.headless),
+        application(application) {
+        if (headless) {
+            initialize_headless();
+        } else {
+            initialize_window(properties);
+        }
+    }
+
+    Window::~Window() {
+        if (framebuffer != nullptr) {
+            Framebuffer::set_default(nullptr);
+            framebuffer.reset();
+        }
+
+#ifdef BB_HEADLESS
+        if (display != nullptr) {
+            eglMakeCurrent(display, EGL_NO_SURFACE, EGL_NO_SURFACE, EGL_NO_CONTEXT);
+            eglDestroyContext(display, context);
+            eglTerminate(display);
+        }
+#endif
+
+        if (window != nullptr) {
+            SDL_GL_DeleteContext(static_cast<SDL_GLContext>(context));
+            SDL_DestroyWindow(window);
+        }
+
+        SDL_Quit();
+    }
+
+    void Window::initialize_window(const WindowProperties& properties) {
         if (SDL_Init(SDL_INIT_VIDEO | SDL_INIT_AUDIO) < 0) {
-            log_message("Could not initialize SDL: %s\n", SDL_GetError());
+            BB_LOG_ERROR(Window, "Could not initialize SDL: %s\n", SDL_GetError());
             throw InitializationError;
         }
 
@@ -43,14 +85,14 @@ namespace bb {
         );
 
         if (window == nullptr) {
-            log_message("Could not create window: %s\n", SDL_GetError());
+            BB_LOG_ERROR(Window, "Could not create window: %s\n", SDL_GetError());
             throw InitializationError;
         }
 
         context = SDL_GL_CreateContext(window);
 
         if (!gladLoadGL()) {
-            log_message("Could not initialize glad\n");
+            BB_LOG_ERROR(Window, "Could not initialize glad\n");
             throw InitializationError;
         }
 
@@ -61,28 +103,174 @@ namespace bb {
         SDL_SetWindowMinimumSize(window, properties.min_width, properties.min_height);
     }
 
-    Window::~Window() {
-        SDL_GL_DeleteContext(static_cast<SDL_GLContext>(context));
-        SDL_DestroyWindow(window);
-        SDL_Quit();
+    void Window::initialize_headless() {
+        // There may be no sound device either
+        SDL_setenv("SDL_AUDIODRIVER", "dummy", 0);
+
+#ifdef BB_HEADLESS
+        if (SDL_Init(SDL_INIT_AUDIO | SDL_INIT_EVENTS) < 0) {
+            BB_LOG_ERROR(Window, "Could not initialize SDL: %s\n", SDL_GetError());
+            throw InitializationError;
+        }
+
+        create_egl_context();
+#else
+        // Without EGL, a window that is never shown is the next best thing, but it still needs a display
+        BB_LOG_WARNING(Window, "Built without BB_HEADLESS; rendering offscreen with a hidden window\n");
+
+        if (SDL_Init(SDL_INIT_VIDEO | SDL_INIT_AUDIO) < 0) {
+            BB_LOG_ERROR(Window, "Could not initialize SDL: %s\n", SDL_GetError());
+            throw InitializationError;
+        }
+
+        SDL_GL_SetAttribute(SDL_GL_CONTEXT_MAJOR_VERSION, 4);
+        SDL_GL_SetAttribute(SDL_GL_CONTEXT_MINOR_VERSION, 3);
+
+        window = SDL_CreateWindow("", 0, 0, 1, 1, SDL_WINDOW_OPENGL | SDL_WINDOW_HIDDEN);
+
+        if (window == nullptr) {
+            BB_LOG_ERROR(Window, "Could not create window: %s\n", SDL_GetError());
+            throw InitializationError;
+        }
+
+        context = SDL_GL_CreateContext(window);
+
+        if (context == nullptr) {
+            BB_LOG_ERROR(Window, "Could not create OpenGL context: %s\n", SDL_GetError());
+            throw InitializationError;
+        }
+
+        if (!gladLoadGL()) {
+            BB_LOG_ERROR(Window, "Could not initialize glad\n");
+            throw InitializationError;
+        }
+#endif
+
+        // Everything that would go to the screen goes here instead
+        FramebufferSpecification specification;
+        specification.width = width;
+        specification.height = height;
+        specification.color_attachments = {
+            Attachment(AttachmentFormat::Rgba8, AttachmentType::Renderbuffer)
+        };
+        specification.depth_attachment = Attachment(
+            AttachmentFormat::Depth24Stencil8, AttachmentType::Renderbuffer
+        );
+        specification.resizable = false;
+
+        framebuffer = std::make_unique<Framebuffer>(specification);
+        Framebuffer::set_default(framebuffer.get());
+
+        // There is no surface to take the size from
+        glViewport(0, 0, width, height);
+
+        BB_LOG_INFO(
+            Window,
+            "Rendering headless at %dx%d with %s\n",
+            width,
+            height,
+            reinterpret_cast<const char*>(glGetString(GL_RENDERER))
+        );
+    }
+
+#ifdef BB_HEADLESS
+    void Window::create_egl_context() {
+        // Mesa renders without any display, on the GPU or with llvmpipe
+        EGLDisplay egl_display {EGL_NO_DISPLAY};
+
+        const auto get_platform_display {
+            reinterpret_cast<PFNEGLGETPLATFORMDISPLAYEXTPROC>(eglGetProcAddress("eglGetPlatformDisplayEXT"))
+        };
+
+        if (get_platform_display != nullptr) {
+            egl_display = get_platform_display(EGL_PLATFORM_SURFACELESS_MESA, EGL_DEFAULT_DISPLAY, nullptr);
+        }
+
+        if (egl_display == EGL_NO_DISPLAY) {
+            egl_display = eglGetDisplay(EGL_DEFAULT_DISPLAY);
+        }
+
+        if (egl_display == EGL_NO_DISPLAY || eglInitialize(egl_display, nullptr, nullptr) == EGL_FALSE) {
+            BB_LOG_ERROR(Window, "Could not initialize EGL: 0x%x\n", eglGetError());
+            throw InitializationError;
+        }
+
+        display = egl_display;
+
+        if (eglBindAPI(EGL_OPENGL_API) == EGL_FALSE) {
+            BB_LOG_ERROR(Window, "Could not bind OpenGL to EGL: 0x%x\n", eglGetError());
+            throw InitializationError;
+        }
+
+        const EGLint attributes[] {
+            EGL_CONTEXT_MAJOR_VERSION, 4,
+            EGL_CONTEXT_MINOR_VERSION, 3,
+            EGL_CONTEXT_OPENGL_PROFILE_MASK, EGL_CONTEXT_OPENGL_CORE_PROFILE_BIT,
+            EGL_NONE
+        };
+
+        // Nothing is drawn to a surface, so no configuration is needed
+        context = eglCreateContext(egl_display, EGL_NO_CONFIG_KHR, EGL_NO_CONTEXT, attributes);
+
+        if (context == EGL_NO_CONTEXT) {
+            BB_LOG_ERROR(Window, "Could not create OpenGL context: 0x%x\n", eglGetError());
+            throw InitializationError;
+        }
+
+        if (eglMakeCurrent(egl_display, EGL_NO_SURFACE, EGL_NO_SURFACE, context) == EGL_FALSE) {
+            BB_LOG_ERROR(Window, "Could not make OpenGL context current: 0x%x\n", eglGetError());
+            throw InitializationError;
+        }
+
+        if (!gladLoadGLLoader(reinterpret_cast<GLADloadproc>(eglGetProcAddress))) {
+            BB_LOG_ERROR(Window, "Could not initialize glad\n");
+            throw InitializationError;
+        }
     }
+#endif
 
     void Window::set_vsync(bool enabled) {
+        if (headless) {
+            return;  // Nothing to wait for
+        }
+
         if (SDL_GL_SetSwapInterval(static_cast<int>(enabled)) < 0) {
             throw OtherError;
         }
     }
 
     void Window::capture_mouse(bool enabled) {
+        if (headless) {
+            return;
+        }
+
         if (SDL_SetRelativeMouseMode(enabled ? SDL_TRUE : SDL_FALSE) < 0) {
             throw OtherError;
         }
     }
 
+    static bool is_input_event(unsigned int type) {
+        switch (type) {
+            case SDL_KEYDOWN:
+            case SDL_KEYUP:
+            case SDL_MOUSEMOTION:
+            case SDL_MOUSEBUTTONDOWN:
+            case SDL_MOUSEBUTTONUP:
+            case SDL_MOUSEWHEEL:
+                return true;
+            default:
+                return false;
+        }
+    }
+
     void Window::poll_events() {
         SDL_Event event;
 
         while (SDL_PollEvent(&event)) {
+            if (!input_enabled && is_input_event(event.type)) {
+                continue;
+            }
+
             switch (event.type) {
                 case SDL_QUIT:
                     application->events.enqueue<WindowClosedEvent>();
@@ -148,6 +336,10 @@ namespace bb {
     }
 
     void Window::refresh() const {
+        if (headless) {
+            return;  // The frame stays in the framebuffer, to be read
+        }
+
         SDL_GL_SwapWindow(window);
     }
 
@@ -158,4 +350,53 @@ namespace bb {
         return static_cast<double>(SDL_GetTicks64()) / 1000.0;
 #endif
     }
+
+    void Window::read_frame(std::vector<unsigned char>& pixels) const {
+        pixels.resize(static_cast<std::size_t>(width) * static_cast<std::size_t>(height) * 4);
+
+        Framebuffer::bind_default();
+        glReadBuffer(headless ? GL_COLOR_ATTACHMENT0 : GL_BACK);
+        glReadPixels(0, 0, width, height, GL_RGBA, GL_UNSIGNED_BYTE, pixels.data());
+    }
+
+    bool Window::save_frame(const std::string& file_path) const {
+        std::vector<unsigned char> pixels;
+        read_frame(pixels);
+
+        const std::size_t pitch {static_cast<std::size_t>(width) * 4};
+        std::vector<unsigned char> image(pixels.size());
+
+        // OpenGL starts from the bottom row, images from the top
+        for (int y {0}; y < height; y++) {
+            std::memcpy(
+                image.data() + static_cast<std::size_t>(y) * pitch,
+                pixels.data() + static_cast<std::size_t>(height - 1 - y) * pitch,
+                pitch
+            );
+        }
+
+        // Alpha means nothing on the screen
+        for (std::size_t i {3}; i < image.size(); i += 4) {
+            image[i] = 255;
+        }
+
+        SDL_Surface* surface {SDL_CreateRGBSurfaceWithFormatFrom(
+            image.data(), width, height, 32, static_cast<int>(pitch), SDL_PIXELFORMAT_RGBA32
+        )};
+
+        if (surface == nullptr) {
+            BB_LOG_ERROR(Window, "Could not create surface: %s\n", SDL_GetError());
+            return false;
+        }
+
+        const bool saved {IMG_SavePNG(surface, file_path.c_str()) == 0};
+
+        SDL_FreeSurface(surface);
+
+        if (!saved) {
+            BB_LOG_ERROR(Window, "Could not save frame to `%s`: %s\n", file_path.c_str(), IMG_GetError());
+        }
+
+        return saved;
+    }
 }
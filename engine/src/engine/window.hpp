@@ -1,11 +1,14 @@
 #pragma once
 
 #include <string>
+#include <vector>
+#include <memory>
 
 struct SDL_Window;
 
 namespace bb {
     class Application;
+    class Framebuffer;
 
     struct WindowProperties {
         int width {};
@@ -14,6 +17,7 @@ namespace bb {
         bool fullscreen {};
         int min_width {};
         int min_height {};
+        bool headless {};  // Render offscreen, without a window or a display
     };
 
     class Window {
@@ -28,19 +32,37 @@ namespace bb {
 
         int get_width() const { return width; }
         int get_height() const { return height; }
+        bool is_headless() const { return headless; }
 
         void set_vsync(bool enabled);
         void capture_mouse(bool enabled);
+        void set_input_enabled(bool enabled) { input_enabled = enabled; }  // Window events still come through
 
         void poll_events();
         void refresh() const;
         static double get_time();  // In seconds
+
+        // What has been rendered in the current frame, before refresh, in RGBA from the bottom row up
+        void read_frame(std::vector<unsigned char>& pixels) const;
+
+        // Return false, if the image couldn't be written
+        bool save_frame(const std::string& file_path) const;
     private:
+        void initialize_window(const WindowProperties& properties);
+        void initialize_headless();
+        void create_egl_context();
+
         int width {};
         int height {};
+        bool input_enabled {true};
+        bool headless {false};
 
-        SDL_Window* window {nullptr};
+        SDL_Window* window {nullptr};  // Null, if headless with EGL
         void* context {nullptr};
+        void* display {nullptr};  // Of EGL, if headless
         Application* application {nullptr};
+
+        // Stands in for the screen, if headless
+        std::unique_ptr<Framebuffer> framebuffer;
     };
 }